@@ -0,0 +1,185 @@
+/**
+ * @file    Backtest_bench.cpp
+ * @brief   Throughput benchmark for the event-driven Backtest.
+ *
+ * Streams synthetic minute bars through Backtest::run with a strategy that only
+ * reads each bar and with a moving average cross that trades, once over a single
+ * source and once over a merge of NUM_MERGED sources with the same total number
+ * of bars, and reports bars/sec on one core, the read only runs are checked
+ * against the target in Backtest_lib.h.
+ *
+ * Build like test.cpp with src/Backtest_lib.cpp and its dependencies, add -O2.
+ *
+ * @author  Benny Zaionz
+ * @date    2026-10-18
+ * @version 1.0
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Backtest_lib.h"
+
+using namespace AlgoTrading;
+
+const int NUM_BARS = 4000000;
+const int NUM_MERGED = 8;
+const int NUM_REPEATS = 5;
+const double TARGET_BARS_PER_SEC = 20e6;
+
+template<typename F>
+double timeIt(F run)
+{
+    double best = 1e30;
+
+    for( int r = 0; r < NUM_REPEATS; r++ )
+    {
+        auto start = std::chrono::steady_clock::now();
+        run();
+        auto end = std::chrono::steady_clock::now();
+
+        best = std::min(best, std::chrono::duration<double>(end - start).count());
+    }
+
+    return best;
+}
+
+void report(const std::string& name, const double seconds, const BacktestResult& result, const bool tracked)
+{
+    const double rate = result.num_bars / seconds;
+
+    std::cout << name << ": " << (rate / 1e6) << " M bars/sec"
+              << ", " << (seconds * 1e9 / result.num_bars) << " ns/bar"
+              << (tracked && rate < TARGET_BARS_PER_SEC ? " (below target)" : "")
+              << " (fills " << result.num_fills << ", final value " << result.final_value << ")" << std::endl;
+}
+
+std::unique_ptr<HistoricalEquityData> makeHistory(const std::string& ticker_, const int num_bars, const int seed)
+{
+    std::mt19937_64 rng(seed);
+    std::normal_distribution<double> step(0, 0.0005);
+
+    std::vector<DateTime> datetimes(num_bars);
+    std::vector<double> last(num_bars), low(num_bars), high(num_bars), bid(num_bars), ask(num_bars);
+    std::vector<int> volume(num_bars, 100);
+
+    DateTime dt(2015, 1, 2, 9, 30, 0);
+    double price = 100;
+
+    for( int i = 0; i < num_bars; i++ )
+    {
+        price *= std::exp(step(rng));
+
+        datetimes[i] = dt;
+        last[i] = price;
+        low[i] = price * 0.999;
+        high[i] = price * 1.001;
+        bid[i] = price - 0.01;
+        ask[i] = price + 0.01;
+        dt += 60;
+    }
+
+    auto hist = std::make_unique<HistoricalEquityData>(ticker_, MINS, 1);
+    hist->append_columns(datetimes, last, low, high, bid, ask, volume);
+
+    return hist;
+}
+
+class ReadOnly: public Strategy
+{
+    public:
+
+        double sum = 0;
+
+        void onBar(Backtest& /*backtest*/, const int /*source*/, const SnapshotRef& bar) override { sum += bar.getLast(); }
+};
+
+class MovingAverageCross: public Strategy
+{
+    /*
+    10 / 50 bar simple moving averages per source from running sums over the last column,
+    long 100 shares while the fast one is above the slow one, flat otherwise
+    */
+
+    private:
+
+        struct State
+        {
+            double fast_sum = 0;
+            double slow_sum = 0;
+            int count = 0;
+        };
+
+        std::vector<State> states;
+
+    public:
+
+        void onStart(Backtest& backtest) override { states.assign(backtest.getNumSources(), State()); }
+
+        void onBar(Backtest& backtest, const int source, const SnapshotRef& bar) override
+        {
+            const int FAST = 10, SLOW = 50;
+
+            State& state = states[source];
+            std::span<const double> last = backtest.getSource(source).getPriceColumn(LAST);
+            const int row = bar.getIndex();
+
+            state.fast_sum += last[row];
+            state.slow_sum += last[row];
+            if( row >= FAST ) state.fast_sum -= last[row - FAST];
+            if( row >= SLOW ) state.slow_sum -= last[row - SLOW];
+
+            if( ++state.count < SLOW )
+                return;
+
+            backtest.orderTarget(source, state.fast_sum / FAST > state.slow_sum / SLOW ? 100 : 0);
+        }
+};
+
+int main()
+{
+    std::unique_ptr<HistoricalEquityData> single = makeHistory("SINGLE", NUM_BARS, 1);
+
+    std::vector<std::unique_ptr<HistoricalEquityData>> merged;
+    std::vector<const HistoricalEquityData*> merged_sources;
+
+    for( int i = 0; i < NUM_MERGED; i++ )
+    {
+        merged.push_back(makeHistory("MERGED" + std::to_string(i), NUM_BARS / NUM_MERGED, i + 2));
+        merged_sources.push_back(merged.back().get());
+    }
+
+    BacktestConfig config;
+    config.initial_cash = 1e6;
+
+    Backtest single_backtest({ single.get() }, config);
+    Backtest merged_backtest(merged_sources, config);
+
+    std::cout << "target: " << TARGET_BARS_PER_SEC / 1e6 << " M bars/sec per core" << std::endl;
+
+    BacktestResult result;
+    ReadOnly read_only;
+    MovingAverageCross cross;
+
+    double seconds = timeIt([&]() { result = single_backtest.run(read_only); });
+    report("1 source, read only        ", seconds, result, true);
+
+    seconds = timeIt([&]() { result = merged_backtest.run(read_only); });
+    report("8 sources, read only       ", seconds, result, true);
+
+    seconds = timeIt([&]() { result = single_backtest.run(cross); });
+    report("1 source, moving avg cross ", seconds, result, false);
+
+    seconds = timeIt([&]() { result = merged_backtest.run(cross); });
+    report("8 sources, moving avg cross", seconds, result, false);
+
+    std::cout << "(checksum " << read_only.sum << ")" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,120 @@
+/**
+ * @file    DateTime_bench.cpp
+ * @brief   Microbenchmark for parsing TWS date strings into DateTime.
+ *
+ * Compares the original substr + std::stoi constructor (reproduced below as
+ * legacyParse) against DateTime::parse and DateTime::parseBatch on the same
+ * set of "YYYYMMDD hh:mm:ss" and "YYYYMMDD" strings.
+ *
+ * Build like test.cpp, add -msse4.1 (or -march=native) for the SIMD batch path.
+ *
+ * @author  Benny Zaionz
+ * @date    2026-10-18
+ * @version 1.0
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "DateTime.h"
+
+using namespace AlgoTrading;
+
+const int NUM_STRINGS = 1000000;
+const int NUM_REPEATS = 5;
+
+DateTime legacyParse(const std::string& datetime_)
+{
+    if( datetime_.size() == 8)
+        return DateTime(std::stoi(datetime_.substr(0, 4)),
+                        std::stoi(datetime_.substr(4, 2)),
+                        std::stoi(datetime_.substr(6, 2)));
+
+    return DateTime(std::stoi(datetime_.substr(0, 4)),
+                    std::stoi(datetime_.substr(4, 2)),
+                    std::stoi(datetime_.substr(6, 2)),
+                    std::stoi(datetime_.substr(9, 10)),
+                    std::stoi(datetime_.substr(12, 13)),
+                    std::stoi(datetime_.substr(15, 16)));
+}
+
+template<typename F>
+double timeIt(F run)
+{
+    double best = 1e30;
+
+    for( int r = 0; r < NUM_REPEATS; r++ )
+    {
+        auto start = std::chrono::steady_clock::now();
+        run();
+        auto end = std::chrono::steady_clock::now();
+
+        best = std::min(best, std::chrono::duration<double>(end - start).count());
+    }
+
+    return best;
+}
+
+void report(const std::string& name, const double seconds, const std::int64_t checksum)
+{
+    std::cout << name << ": " << (NUM_STRINGS / seconds / 1e6) << " M strings/sec"
+              << ", " << (seconds * 1e9 / NUM_STRINGS) << " ns/string"
+              << " (checksum " << checksum << ")" << std::endl;
+}
+
+int main()
+{
+    std::vector<std::string> strings;
+    strings.reserve(NUM_STRINGS);
+
+    DateTime dt(2015, 1, 2, 9, 30, 0);
+
+    for( int i = 0; i < NUM_STRINGS; i++ )
+    {
+        char buffer[32];
+
+        if( i % 10 == 0 ) // mix in some daily bars
+            std::snprintf(buffer, sizeof(buffer), "%04d%02d%02d", dt.getYear(), dt.getMonth(), dt.getDay());
+        else
+            std::snprintf(buffer, sizeof(buffer), "%04d%02d%02d %02d:%02d:%02d", dt.getYear(), dt.getMonth(), dt.getDay(),
+                          dt.getHour(), dt.getMin(), dt.getSec());
+
+        strings.push_back(buffer);
+        dt += 37;
+    }
+
+    std::vector<std::string_view> views(strings.begin(), strings.end());
+    std::vector<DateTime> parsed(NUM_STRINGS);
+    std::int64_t checksum = 0;
+
+    double legacy = timeIt([&]() {
+        for( int i = 0; i < NUM_STRINGS; i++ )
+            parsed[i] = legacyParse(strings[i]);
+    });
+    checksum = 0;
+    for( const DateTime& d : parsed ) checksum += d.getEpoch();
+    report("legacy substr + stoi", legacy, checksum);
+
+    double single = timeIt([&]() {
+        for( int i = 0; i < NUM_STRINGS; i++ )
+            DateTime::parse(views[i], parsed[i]);
+    });
+    checksum = 0;
+    for( const DateTime& d : parsed ) checksum += d.getEpoch();
+    report("DateTime::parse     ", single, checksum);
+
+    double batch = timeIt([&]() {
+        DateTime::parseBatch(views, parsed);
+    });
+    checksum = 0;
+    for( const DateTime& d : parsed ) checksum += d.getEpoch();
+    report("DateTime::parseBatch", batch, checksum);
+
+    std::cout << "speedup parse: " << legacy / single << "x, parseBatch: " << legacy / batch << "x" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,167 @@
+/**
+ * @file    RiskEngine_bench.cpp
+ * @brief   Microbenchmark for the pre-trade checks of RiskEngine.
+ *
+ * Runs a stream of random orders over NUM_SYMBOLS symbols through RiskEngine::check
+ * alone, then the orders the checks accept through Portfolio::buyEquity / sellEquity
+ * alone and through RiskEngine::submit (check + Portfolio + exposure update), so the
+ * difference of the last two is the cost the RiskEngine adds to an order that goes
+ * through. Finally times single checks one at a time for the latency percentiles.
+ * The budget is about a microsecond per order on top of the Portfolio.
+ *
+ * Build like test.cpp with src/RiskEngine.cpp and its dependencies, add -O2.
+ *
+ * @author  Benny Zaionz
+ * @date    2026-10-18
+ * @version 1.0
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "RiskEngine.h"
+
+using namespace AlgoTrading;
+
+const int NUM_SYMBOLS = 5000;
+const int NUM_ORDERS = 1000000;
+const int NUM_REPEATS = 5;
+
+template<typename F>
+double timeIt(F run)
+{
+    double best = 1e30;
+
+    for( int r = 0; r < NUM_REPEATS; r++ )
+    {
+        auto start = std::chrono::steady_clock::now();
+        run();
+        auto end = std::chrono::steady_clock::now();
+
+        best = std::min(best, std::chrono::duration<double>(end - start).count());
+    }
+
+    return best;
+}
+
+void report(const std::string& name, const double seconds, const std::int64_t checksum, const std::size_t num_orders = NUM_ORDERS)
+{
+    std::cout << name << ": " << (num_orders / seconds / 1e6) << " M orders/sec"
+              << ", " << (seconds * 1e9 / num_orders) << " ns/order"
+              << " (checksum " << checksum << ")" << std::endl;
+}
+
+int main()
+{
+    std::mt19937_64 rng(42);
+    std::vector<SymbolId> symbols(NUM_SYMBOLS);
+    std::vector<Price> mids(NUM_SYMBOLS);
+
+    RiskLimits limits;
+    limits.max_order_shares = 2000;
+    limits.max_position_shares = 20000;
+    limits.max_order_notional = Money::fromUnits(250000);
+    limits.max_gross_notional = Money::fromUnits(500000000);
+    limits.max_net_notional = Money::fromUnits(100000000);
+    limits.price_band_bps = 200;
+
+    RiskEngine risk(limits);
+
+    for( int i = 0; i < NUM_SYMBOLS; i++ )
+    {
+        symbols[i] = internSymbol("SYM" + std::to_string(i));
+        mids[i] = Price::fromTicks(static_cast<std::int64_t>(rng() % 5000000) + 10000); // $1 to $501
+
+        const Price spread = Price::fromTicks(100);
+        risk.updateMarket(symbols[i], mids[i] - spread, mids[i] + spread, mids[i]);
+    }
+
+    // mostly sane orders, a few oversized or priced through the band
+    std::vector<Order> orders(NUM_ORDERS);
+
+    for( Order& order : orders )
+    {
+        const int i = static_cast<int>(rng() % NUM_SYMBOLS);
+        const std::int64_t offset = static_cast<std::int64_t>(rng() % 600) - 300; // +-3%
+
+        order.symbol = symbols[i];
+        order.side = rng() % 2 == 0 ? BUY : SELL;
+        order.quantity = static_cast<int>(rng() % 2500) + 1;
+        order.price = mids[i] + mids[i].scaledBy(offset, 10000);
+    }
+
+    std::int64_t checksum = 0;
+
+    double check_only = timeIt([&]() {
+        checksum = 0;
+        for( const Order& order : orders )
+            checksum += risk.check(order);
+    });
+    report("RiskEngine::check   ", check_only, checksum);
+
+    /*
+    the orders that pass the checks, from a fresh Portfolio as in the runs below. Rejected orders change
+    nothing, so submitting only these accepts them all again and the Portfolio only and submit runs make
+    the same Portfolio calls, their difference is what the checks and the exposure update add
+    */
+    std::vector<Order> accepted;
+
+    {
+        Portfolio portfolio(1e12);
+        risk.syncPositions(portfolio);
+
+        for( const Order& order : orders )
+            if( risk.submit(portfolio, order).risk == RISK_ACCEPTED )
+                accepted.push_back(order);
+    }
+
+    std::cout << accepted.size() << " of " << NUM_ORDERS << " orders pass the checks" << std::endl;
+
+    double portfolio_only = timeIt([&]() {
+        Portfolio portfolio(1e12);
+        checksum = 0;
+        for( const Order& order : accepted )
+            checksum += order.side == BUY ? portfolio.buyEquity(order.symbol, order.quantity, order.price)
+                                          : portfolio.sellEquity(order.symbol, order.quantity, order.price);
+    });
+    report("Portfolio only      ", portfolio_only, checksum, accepted.size());
+
+    double submitted = timeIt([&]() {
+        Portfolio portfolio(1e12);
+        risk.syncPositions(portfolio);
+        checksum = 0;
+        for( const Order& order : accepted )
+        {
+            const RiskResult result = risk.submit(portfolio, order);
+            checksum += result.risk * 8 + result.status;
+        }
+    });
+    report("RiskEngine::submit  ", submitted, checksum, accepted.size());
+
+    std::cout << "added per accepted order: " << (submitted - portfolio_only) * 1e9 / accepted.size() << " ns" << std::endl;
+
+    // one check at a time, includes the cost of reading the clock
+    std::vector<double> latencies(NUM_ORDERS);
+    checksum = 0;
+
+    for( int i = 0; i < NUM_ORDERS; i++ )
+    {
+        auto start = std::chrono::steady_clock::now();
+        checksum += risk.check(orders[i]);
+        auto end = std::chrono::steady_clock::now();
+
+        latencies[i] = std::chrono::duration<double, std::nano>(end - start).count();
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    std::cout << "single check p50 " << latencies[NUM_ORDERS / 2] << " ns, p99 " << latencies[NUM_ORDERS * 99 / 100]
+              << " ns, p99.9 " << latencies[NUM_ORDERS * 999 / 1000] << " ns, max " << latencies.back() << " ns"
+              << " (checksum " << checksum << ")" << std::endl;
+
+    return 0;
+}
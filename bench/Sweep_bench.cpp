@@ -0,0 +1,139 @@
+/**
+ * @file    Sweep_bench.cpp
+ * @brief   Scaling benchmark for runSweep over a work-stealing ThreadPool.
+ *
+ * Runs the same grid of moving average windows over one shared synthetic minute
+ * history with 1, 2, 4, ... threads up to the hardware concurrency and reports
+ * runs/sec and the parallel efficiency against one thread. The averages are
+ * recomputed from scratch every bar, so a run's length grows with its slow window
+ * and the grid mixes runs roughly 20x apart in length, the case stealing is for.
+ *
+ * Build like test.cpp with src/ThreadPool.cpp, src/Backtest_lib.cpp and their
+ * dependencies, add -O2 -pthread.
+ *
+ * @author  Benny Zaionz
+ * @date    2026-10-18
+ * @version 1.0
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "ParameterSweep.h"
+
+using namespace AlgoTrading;
+
+const int NUM_BARS = 100000;
+
+struct CrossParams
+{
+    int fast;
+    int slow;
+};
+
+class NaiveCross: public Strategy
+{
+    private:
+
+        CrossParams params;
+
+        static double average(std::span<const double> last, const int row, const int window)
+        {
+            double sum = 0;
+
+            for( int i = row - window + 1; i <= row; i++ )
+                sum += last[i];
+
+            return sum / window;
+        }
+
+    public:
+
+        NaiveCross(const CrossParams& params_): params(params_) {}
+
+        void onBar(Backtest& backtest, const int source, const SnapshotRef& bar) override
+        {
+            const int row = bar.getIndex();
+
+            if( row + 1 < params.slow )
+                return;
+
+            std::span<const double> last = backtest.getSource(source).getPriceColumn(LAST);
+
+            backtest.orderTarget(source, average(last, row, params.fast) > average(last, row, params.slow) ? 100 : 0);
+        }
+};
+
+int main()
+{
+    std::mt19937_64 rng(7);
+    std::normal_distribution<double> step(0, 0.0005);
+
+    std::vector<DateTime> datetimes(NUM_BARS);
+    std::vector<double> last(NUM_BARS);
+    std::vector<int> volume(NUM_BARS, 100);
+
+    DateTime dt(2015, 1, 2, 9, 30, 0);
+    double price = 100;
+
+    for( int i = 0; i < NUM_BARS; i++ )
+    {
+        price *= std::exp(step(rng));
+        datetimes[i] = dt;
+        last[i] = price;
+        dt += 60;
+    }
+
+    HistoricalEquityData hist("SWEEP", MINS, 1);
+    hist.append_columns(datetimes, last, last, last, last, last, volume);
+
+    std::vector<CrossParams> grid;
+
+    for( int fast = 2; fast <= 20; fast += 2 )
+        for( int slow = 25; slow <= 500; slow += 25 )
+            grid.push_back(CrossParams{ fast, slow });
+
+    BacktestConfig config;
+    config.initial_cash = 1e6;
+    config.record_equity = false;
+    config.record_fills = false;
+
+    const int max_threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    double single = 0;
+
+    std::cout << grid.size() << " runs of " << NUM_BARS << " bars, " << max_threads << " hardware threads" << std::endl;
+
+    for( int num_threads = 1; ; num_threads = std::min(num_threads * 2, max_threads) )
+    {
+        ThreadPool pool(num_threads);
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<BacktestResult> results = runSweep(pool, { &hist }, config, std::span<const CrossParams>(grid),
+                                                       [](const CrossParams& params) { return NaiveCross(params); });
+        auto end = std::chrono::steady_clock::now();
+
+        const double seconds = std::chrono::duration<double>(end - start).count();
+
+        if( num_threads == 1 )
+            single = seconds;
+
+        double checksum = 0;
+        for( const BacktestResult& result : results ) checksum += result.final_value;
+
+        std::cout << num_threads << " threads: " << grid.size() / seconds << " runs/sec"
+                  << ", speedup " << single / seconds << "x"
+                  << ", efficiency " << 100 * single / seconds / num_threads << "%"
+                  << " (checksum " << checksum << ")" << std::endl;
+
+        if( num_threads == max_threads )
+            break;
+    }
+
+    return 0;
+}
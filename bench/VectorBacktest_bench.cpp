@@ -0,0 +1,183 @@
+/**
+ * @file    VectorBacktest_bench.cpp
+ * @brief   Benchmark of runVectorized against the event-driven Backtest.
+ *
+ * Runs a 10 / 50 moving average cross over a synthetic daily history and a
+ * synthetic minute history, once as a Strategy computing its averages bar by bar
+ * through Backtest::run and once as movingAverageCrossTargets + runVectorized,
+ * then reports the speedup and checks the two agree: same fills, rejections,
+ * commissions and final value, equity within half a tick per share held.
+ *
+ * Build like test.cpp with src/VectorBacktest.cpp, src/Backtest_lib.cpp and
+ * their dependencies, add -O2 (-march=native for wider vectors).
+ *
+ * Expected speedup, measured on a shared AVX-512 machine with GCC 12 (noisy): daily
+ * 4x to 7x with -O2 and 6x to 10x with -O3, minute 3x to 4.5x with -O2 and 4x to 6x
+ * with -O3. This is short of the 10x first asked for. The 2M bar minute history streams
+ * about 40 bytes per bar through memory (prices twice, targets written and read back,
+ * equity written), so the vectorized path is bound by memory bandwidth at 4 to 8 ns per
+ * bar while the event-driven path spends 20 to 45 ns per bar on computation. Getting
+ * further needs the signal fused into runVectorized block by block, or no equity curve.
+ *
+ * @author  Benny Zaionz
+ * @date    2026-10-18
+ * @version 1.0
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "VectorBacktest.h"
+
+using namespace AlgoTrading;
+
+const int NUM_DAILY_BARS = 5000;
+const int NUM_MINUTE_BARS = 2000000;
+const int NUM_REPEATS = 5;
+const int FAST = 10;
+const int SLOW = 50;
+const int SHARES = 100;
+
+template<typename F>
+double timeIt(F run)
+{
+    double best = 1e30;
+
+    for( int r = 0; r < NUM_REPEATS; r++ )
+    {
+        auto start = std::chrono::steady_clock::now();
+        run();
+        auto end = std::chrono::steady_clock::now();
+
+        best = std::min(best, std::chrono::duration<double>(end - start).count());
+    }
+
+    return best;
+}
+
+HistoricalEquityData makeHistory(const std::string& ticker_, const int step_unit_, const int num_bars, const double volatility)
+{
+    std::mt19937_64 rng(11);
+    std::normal_distribution<double> step(0, volatility);
+
+    std::vector<DateTime> datetimes(num_bars);
+    std::vector<double> last(num_bars), bid(num_bars), ask(num_bars);
+    std::vector<int> volume(num_bars, 100);
+
+    DateTime dt(2000, 1, 3, 16, 0, 0);
+    const int seconds = step_unit_ == DAYS ? 86400 : 60;
+    double price = 100;
+
+    for( int i = 0; i < num_bars; i++ )
+    {
+        price *= std::exp(step(rng));
+        datetimes[i] = dt;
+        last[i] = price;
+        bid[i] = price - 0.01;
+        ask[i] = price + 0.01;
+        dt += seconds;
+    }
+
+    HistoricalEquityData hist(ticker_, step_unit_, 1);
+    hist.append_columns(datetimes, last, last, last, bid, ask, volume);
+
+    return hist;
+}
+
+class MovingAverageCross: public Strategy
+{
+    /*
+    the same rule as movingAverageCrossTargets, running sums of the prices in ticks
+    */
+
+    private:
+
+        std::int64_t fast_sum = 0;
+        std::int64_t slow_sum = 0;
+
+        static std::int64_t ticks(const double price) { return Price::fromDouble(price).getTicks(); }
+
+    public:
+
+        void onStart(Backtest& /*backtest*/) override { fast_sum = slow_sum = 0; }
+
+        void onBar(Backtest& backtest, const int source, const SnapshotRef& bar) override
+        {
+            std::span<const double> last = backtest.getSource(source).getPriceColumn(LAST);
+            const int row = bar.getIndex();
+
+            fast_sum += ticks(last[row]) - (row < FAST ? 0 : ticks(last[row - FAST]));
+            slow_sum += ticks(last[row]) - (row < SLOW ? 0 : ticks(last[row - SLOW]));
+
+            if( row < SLOW - 1 )
+                return;
+
+            backtest.orderTarget(source, fast_sum * SLOW > slow_sum * FAST ? SHARES : 0);
+        }
+};
+
+void compare(const std::string& name, const HistoricalEquityData& hist, const BacktestConfig& config)
+{
+    const int n = hist.getSize();
+
+    Backtest backtest({ &hist }, config);
+    MovingAverageCross strategy;
+    BacktestResult event_result;
+
+    std::vector<int> targets(n);
+    std::vector<double> equity(n);
+    BacktestResult vector_result;
+
+    double event_seconds = timeIt([&]() { event_result = backtest.run(strategy); });
+
+    double vector_seconds = timeIt([&]() {
+        movingAverageCrossTargets(hist.getPriceColumn(LAST), FAST, SLOW, SHARES, targets);
+        vector_result = runVectorized(hist, targets, config, equity);
+    });
+
+    // equity curves, one point per bar on both sides
+    double max_difference = 0;
+    const std::vector<EquityPoint>& curve = backtest.getEquityCurve();
+
+    for( int i = 0; i < n; i++ )
+        max_difference = std::max(max_difference, std::abs(curve[i].value.toDouble() - equity[i]));
+
+    const bool match = event_result.num_fills == vector_result.num_fills &&
+                       event_result.num_rejected == vector_result.num_rejected &&
+                       event_result.commissions == vector_result.commissions &&
+                       event_result.final_value == vector_result.final_value &&
+                       max_difference <= 0.00005 * SHARES + 1e-6;
+
+    std::cout << name << ": event " << (event_seconds * 1e9 / n) << " ns/bar"
+              << ", vectorized " << (vector_seconds * 1e9 / n) << " ns/bar"
+              << ", speedup " << event_seconds / vector_seconds << "x"
+              << ", fills " << vector_result.num_fills
+              << ", final value " << vector_result.final_value
+              << ", max equity difference " << max_difference
+              << (match ? " (match)" : " (MISMATCH)") << std::endl;
+}
+
+int main()
+{
+    HistoricalEquityData daily = makeHistory("DAILY", DAYS, NUM_DAILY_BARS, 0.01);
+    HistoricalEquityData minute = makeHistory("MINUTE", MINS, NUM_MINUTE_BARS, 0.0005);
+
+    BacktestConfig config;
+    config.initial_cash = 1e5;
+
+    compare("daily,  next bar fills ", daily, config);
+    compare("minute, next bar fills ", minute, config);
+
+    config.fill_timing = FILL_THIS_BAR;
+    config.cross_spread = true;
+
+    compare("daily,  same bar, spread", daily, config);
+    compare("minute, same bar, spread", minute, config);
+
+    return 0;
+}
@@ -1,6 +1,202 @@
+/**
+ * @file    Backtest_lib.h
+ * @brief   Defines the Backtest class, an event-driven backtest over HistoricalEquityData.
+ *
+ * This file contains the declaration of the Backtest class and the Strategy interface it
+ * drives. Bars from one or more HistoricalEquityData sources are streamed in timestamp
+ * order (a k-way merge, ties go to the lower source index), each is handed to
+ * Strategy::onBar, the orders the strategy places are executed against a Portfolio with
+ * its commission rules, and the fills and the equity curve are recorded. The buffers are
+ * sized before the first bar for one fill per bar and a few pending orders per source, so
+ * the loop only allocates for strategies that order more often than that.
+ *
+ * Throughput target: 20 M bars/sec per core for a strategy that only reads the bar, on a
+ * single source and on a merge of 8 sources, tracked by bench/Backtest_bench.cpp.
+ *
+ * @author  Benny Zaionz
+ * @date    2026-10-18
+ * @version 1.0
+ */
+
 #ifndef BACKTEST_LIB_H
-#define BACKTEST_LIB_H 
+#define BACKTEST_LIB_H
+
+#include <cstdint>
+#include <vector>
+
+#include "HistoricalEquityData.h"
+#include "Portfolio.h"
+
+namespace AlgoTrading
+{
+
+enum FillTiming{ FILL_NEXT_BAR, FILL_THIS_BAR };
+
+class Backtest;
+
+/*---------- STRATEGY ----------*/
+
+class Strategy
+{
+    /*
+    callbacks run on the backtest's thread, orders placed in any of them go through
+    Backtest::order / buy / sell / orderTarget and are filled according to BacktestConfig
+    */
+
+    public:
+
+        virtual ~Strategy() = default;
+
+        virtual void onStart(Backtest& /*backtest*/) {}
+        virtual void onBar(Backtest& backtest, const int source, const SnapshotRef& bar) = 0; // source indexes the sources given to Backtest
+        virtual void onFill(Backtest& /*backtest*/, const int /*source*/, const int /*side*/, const int /*quantity*/, const Price /*price*/) {}
+        virtual void onEnd(Backtest& /*backtest*/) {}
+};
+
+/*---------- CONFIG AND RESULTS ----------*/
+
+struct BacktestConfig
+{
+    double initial_cash = 100000;
+    int fill_timing = FILL_NEXT_BAR; // enum FillTiming, FILL_THIS_BAR trades on the bar the order was placed in (look-ahead on close prices)
+    int fill_price_type = LAST; // enum PriceType
+    bool cross_spread = false; // buys fill at the ask and sells at the bid when the bar has them
+    bool record_equity = true; // one EquityPoint per distinct timestamp
+    bool record_fills = true;
+};
+
+struct EquityPoint
+{
+    DateTime datetime;
+    Money cash;
+    Money value; // cash plus holdings at their last price
+};
+
+struct BacktestFill
+{
+    DateTime datetime;
+    int source;
+    int side; // enum OrderSide
+    int quantity;
+    Price price;
+    Money commission;
+    int status; // enum TradeStatus, rejected orders are recorded too
+};
+
+struct BacktestResult
+{
+    // compact summary of one run, cheap to copy and collect in bulk
+    double initial_value;
+    double final_value;
+    double total_return; // final_value / initial_value - 1
+    double max_drawdown; // largest fall from a running peak as a fraction of the peak, sampled once per timestamp
+    double commissions;
+    int num_fills;
+    int num_rejected;
+    std::int64_t num_bars;
+};
+
+/*---------- BACKTEST ----------*/
+
+class Backtest
+{
+    private:
+
+        struct PendingOrder
+        {
+            int side;
+            int quantity;
+        };
+
+        struct SourceState
+        {
+            const HistoricalEquityData* hist;
+            SymbolId symbol;
+            int position; // next position in time order
+            int row; // row of the latest bar, -1 before the first
+            int shares;
+            int pending_quantity; // net signed quantity of pending, positive buys
+            std::vector<PendingOrder> pending; // keeps its capacity between bars
+        };
+
+        struct MergeEntry
+        {
+            std::int64_t epoch;
+            int source;
+
+            bool operator>(const MergeEntry& other) const { return epoch > other.epoch || (epoch == other.epoch && source > other.source); }
+        };
+
+        BacktestConfig config;
+        std::vector<SourceState> sources;
+        Portfolio portfolio;
+
+        // per-run state
+        Strategy* strategy;
+        std::vector<MergeEntry> heap; // min-heap of the next bar of every unfinished source
+        std::vector<int> pending_sources; // sources with pending orders, for FILL_THIS_BAR
+        DateTime datetime;
+        bool started;
+        std::int64_t num_bars;
+        int num_fills;
+        int num_rejected;
+        Money commissions;
+        Money peak;
+        double max_drawdown;
+
+        std::vector<EquityPoint> equity_curve;
+        std::vector<BacktestFill> fills;
+
+        void reset();
+        void closeTimestamp(); // samples the equity once all bars of datetime are in
+        void processBar(const int source, const int row);
+        void markSource(const SourceState& state); // re-marks the held shares at the latest bar's last price
+        void executePending(const int source);
+        void executePendingSources(); // FILL_THIS_BAR, every source with pending orders and a bar at this timestamp to fill them on
+        Price fillPrice(const SourceState& state, const int side) const; // missing() if the bar has no usable price
+
+    public:
+
+        /*---------- CONSTRUCTOR ----------*/
+
+        // sources_ are only read and must outlive the Backtest, one per symbol (std::invalid_argument otherwise)
+        Backtest(const std::vector<const HistoricalEquityData*>& sources_, const BacktestConfig& config_ = BacktestConfig());
+
+        /*---------- RUNNING ----------*/
+
+        BacktestResult run(Strategy& strategy_); // starts from a fresh Portfolio every call
+
+        /*---------- ORDERS (FROM STRATEGY CALLBACKS) ----------*/
+
+        // market orders for source's symbol, filled at the price picked by BacktestConfig
+        void order(const int source, const int quantity); // signed, positive buys
+        void buy(const int source, const int quantity) { order(source, quantity); }
+        void sell(const int source, const int quantity) { order(source, -quantity); }
+        void orderTarget(const int source, const int shares); // orders the difference to shares, counting pending orders
+
+        /*---------- GETTERS ----------*/
+
+        const BacktestConfig& getConfig() const { return config; }
+        int getNumSources() const { return sources.size(); }
+        const HistoricalEquityData& getSource(const int source) const { return *sources[source].hist; }
+        SymbolId getSymbol(const int source) const { return sources[source].symbol; }
+        int getSourceIndex(const SymbolId symbol_) const; // NOT_CONTAINED if missing
+
+        DateTime getDatetime() const { return datetime; } // of the bar being processed
+        int getRow(const int source) const { return sources[source].row; } // latest bar of source, -1 before its first
+        int getPosition(const int source) const { return sources[source].shares; }
+        int getPendingQuantity(const int source) const { return sources[source].pending_quantity; }
+        const Portfolio& getPortfolio() const { return portfolio; }
+        double getCash() const { return portfolio.getCash(); }
+        double getValue() const { return portfolio.getValue(); }
+
+        /*---------- RESULTS ----------*/
 
+        // from the last run, valid until the next one
+        const std::vector<EquityPoint>& getEquityCurve() const { return equity_curve; }
+        const std::vector<BacktestFill>& getFills() const { return fills; }
+};
 
+} // namespace
 
-#endif
\ No newline at end of file
+#endif // BACKTEST_LIB_H
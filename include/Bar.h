@@ -53,6 +53,13 @@ class Bar
         void setLast(const double last_) { last = last_; }
         void setLow(const double low_) { low = low_; }
         void setHigh(const double high_) { high = high_; }
+
+        /*---------- AGGREGATION ----------*/
+
+        // negative prices are the -1 "no data" sentinel and are ignored
+        bool isEmpty() const { return first < 0; }
+        void update(const double price); // one more price inside the bar
+        void merge(const Bar& bar); // a later, finer bar inside this one, its negative fields are ignored
         
         /*---------- PRINT HELPER ----------*/
 
@@ -61,4 +68,4 @@ class Bar
 
 } // namespace
 
-#endif // EQUITY_SNAPSHOT_H
\ No newline at end of file
+#endif // BAR_H
\ No newline at end of file
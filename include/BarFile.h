@@ -0,0 +1,53 @@
+/**
+ * @file    BarFile.h
+ * @brief   Defines the on-disk layout of a HistoricalEquityData bar file.
+ *
+ * A bar file is a fixed 256 byte header followed by one block per column, in the
+ * order datetime (int64 seconds since epoch), last, low, high, bid, ask (double)
+ * and volume (int32). Every block starts on a 64 byte boundary so the columns can
+ * be used straight out of a memory mapping. Values are stored little-endian.
+ *
+ * Written by HistoricalEquityData::save and opened by HistoricalEquityData::load.
+ *
+ * @author  Benny Zaionz
+ * @date    2026-10-18
+ * @version 1.0
+ */
+
+#ifndef BAR_FILE_H
+#define BAR_FILE_H
+
+#include <cstdint>
+
+namespace AlgoTrading
+{
+
+const char BAR_FILE_MAGIC[8] = { 'A', 'T', 'B', 'A', 'R', 'S', 0, 0 };
+const std::uint32_t BAR_FILE_VERSION = 1;
+const std::uint64_t BAR_FILE_ALIGNMENT = 64;
+const int BAR_FILE_MAX_TICKER = 31; // plus the terminating null
+
+enum BarFileColumn{ COL_DATETIME, COL_LAST, COL_LOW, COL_HIGH, COL_BID, COL_ASK, COL_VOLUME, NUM_BAR_FILE_COLUMNS };
+
+enum BarFileFlags{ BAR_FILE_CHRONOLOGICAL = 1 }; // rows are sorted by datetime
+
+struct BarFileHeader
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t header_size;
+    char ticker[BAR_FILE_MAX_TICKER + 1];
+    std::int32_t step_unit;
+    std::int32_t step_length;
+    std::uint64_t num_rows;
+    std::uint32_t flags;
+    std::uint32_t reserved;
+    std::uint64_t column_offset[NUM_BAR_FILE_COLUMNS]; // from the start of the file
+    std::uint8_t padding[256 - 8 - 4 - 4 - (BAR_FILE_MAX_TICKER + 1) - 4 - 4 - 8 - 4 - 4 - 8 * NUM_BAR_FILE_COLUMNS];
+};
+
+static_assert(sizeof(BarFileHeader) == 256, "BarFileHeader must stay 256 bytes");
+
+} // namespace
+
+#endif // BAR_FILE_H
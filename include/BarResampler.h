@@ -0,0 +1,93 @@
+/**
+ * @file    BarResampler.h
+ * @brief   Defines the BarResampler class which turns fine bars or ticks into coarser bars.
+ *
+ * This file contains the declaration of the BarResampler class and the ResampledBar it
+ * produces. A resampler has one or more targets (a StepSizeUnit and a step length).
+ * Every snapshot fed to it updates the bar currently being built for each target, and
+ * a bar is completed as soon as a snapshot falls into the next period. One pass over
+ * the input produces every target timeframe.
+ *
+ * Periods are aligned to the epoch: seconds, minutes, hours and days to multiples of
+ * their length, weeks to Mondays and months to the first of the month. Input must be
+ * in chronological order.
+ *
+ * @author  Benny Zaionz
+ * @date    2026-10-18
+ * @version 1.0
+ */
+
+#ifndef BAR_RESAMPLER_H
+#define BAR_RESAMPLER_H
+
+#include <cstdint>
+#include <vector>
+
+#include "Bar.h"
+#include "HistoricalEquityData.h"
+
+namespace AlgoTrading
+{
+
+struct ResampledBar
+{
+    DateTime start; // beginning of the period
+    Bar trade;      // from the snapshots' last, low and high
+    Bar bid;
+    Bar ask;
+    long long volume = 0;
+};
+
+class BarResampler
+{
+    private:
+
+        struct Target
+        {
+            int step_unit;
+            int step_length;
+            std::int64_t period; // current period number, only meaningful while open
+            bool open;
+            ResampledBar current;
+            std::vector<ResampledBar> completed;
+        };
+
+        std::vector<Target> targets;
+
+        std::int64_t periodOf(const Target& target, const DateTime& datetime_) const;
+        DateTime periodStart(const Target& target, const std::int64_t period) const;
+
+    public:
+
+        /*---------- CONSTRUCTOR ----------*/
+
+        BarResampler();
+
+        /*---------- TARGETS ----------*/
+
+        int addTarget(const int step_unit_, const int step_length_ = 1); // returns the target id
+        int getNumTargets() const { return targets.size(); }
+
+        /*---------- UPDATING ----------*/
+
+        // only the bar currently being built for each target is touched
+        void update(const EquitySnapshot& snap);
+        void update(const LiveEquity& leq) { update(leq.getCurrentSnapshot()); }
+        void update(const SnapshotRef& row) { update(row.toSnapshot()); }
+        void run(const HistoricalEquityData& hist); // every row, in time order
+        void flush(); // completes the bars still being built
+
+        /*---------- GETTERS ----------*/
+
+        const std::vector<ResampledBar>& getBars(const int target) const { return targets[target].completed; }
+        std::vector<ResampledBar> takeBars(const int target); // moves the completed bars out, for streaming use
+        bool hasCurrentBar(const int target) const { return targets[target].open; }
+        const ResampledBar& getCurrentBar(const int target) const { return targets[target].current; }
+
+        // completed bars as snapshots: last, low, high from the trade bar, bid and ask from their last
+        HistoricalEquityData toHistoricalEquityData(const int target, const std::string& ticker_) const;
+};
+
+} // namespace
+
+#endif // BAR_RESAMPLER_H
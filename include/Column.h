@@ -0,0 +1,123 @@
+/**
+ * @file    Column.h
+ * @brief   Defines the Column class, a contiguous aligned array of one data field.
+ *
+ * This file contains the declaration of the Column class and the AlignedAllocator
+ * it uses. HistoricalEquityData stores each field (datetime, last, low, high, bid,
+ * ask, volume) in its own Column so that a scan over one field only touches that
+ * field's memory. A Column can also borrow memory it does not own (for example a
+ * memory mapped bar file), it copies the values into its own storage the first
+ * time it is modified.
+ *
+ * @author  Benny Zaionz
+ * @date    2026-10-18
+ * @version 1.0
+ */
+
+#ifndef COLUMN_H
+#define COLUMN_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <span>
+#include <vector>
+
+namespace AlgoTrading
+{
+
+const std::size_t COLUMN_ALIGNMENT = 64; // one cache line, also wide enough for AVX-512 loads
+
+/*---------- ALIGNED ALLOCATOR ----------*/
+
+template<typename T, std::size_t Alignment = COLUMN_ALIGNMENT>
+struct AlignedAllocator
+{
+    using value_type = T;
+
+    template<typename U>
+    struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+    AlignedAllocator() = default;
+
+    template<typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+    T* allocate(std::size_t n)
+    {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+    }
+
+    void deallocate(T* p, std::size_t)
+    {
+        ::operator delete(p, std::align_val_t(Alignment));
+    }
+
+    template<typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const { return true; }
+};
+
+/*---------- COLUMN ----------*/
+
+template<typename T>
+class Column
+{
+    private:
+
+        std::vector<T, AlignedAllocator<T>> values;
+
+        // set while borrowing, values is empty until the first modification
+        const T* borrowed;
+        std::size_t borrowed_size;
+        std::shared_ptr<const void> owner; // keeps the borrowed memory alive
+
+        void own()
+        {
+            if( borrowed == nullptr )
+                return;
+
+            values.assign(borrowed, borrowed + borrowed_size);
+            borrowed = nullptr;
+            borrowed_size = 0;
+            owner.reset();
+        }
+
+    public:
+
+        Column(): values{}, borrowed(nullptr), borrowed_size(0), owner{} {}
+
+        /*---------- GETTERS ----------*/
+
+        std::span<const T> view() const { return std::span<const T>(data(), size()); }
+        const T* data() const { return borrowed != nullptr ? borrowed : values.data(); }
+        std::size_t size() const { return borrowed != nullptr ? borrowed_size : values.size(); }
+        std::size_t capacity() const { return borrowed != nullptr ? borrowed_size : values.capacity(); }
+        bool empty() const { return size() == 0; }
+        bool isBorrowed() const { return borrowed != nullptr; }
+
+        const T& operator[](const std::size_t i) const { return data()[i]; }
+
+        /*---------- BORROWING ----------*/
+
+        // views n values at data_ without copying them, owner must keep data_ alive
+        void borrow(const T* data_, const std::size_t n, std::shared_ptr<const void> owner_)
+        {
+            values.clear();
+            borrowed = data_;
+            borrowed_size = n;
+            owner = std::move(owner_);
+        }
+
+        /*---------- APPENDING DATA ----------*/
+
+        void assign(const std::size_t n, const T& value) { own(); values.assign(n, value); }
+        T* mutableData() { own(); return values.data(); } // for filling in place, copies borrowed values first
+        void push_back(const T& value) { own(); values.push_back(value); }
+        void append(std::span<const T> more) { own(); values.insert(values.end(), more.begin(), more.end()); }
+        void reserve(const std::size_t n) { own(); values.reserve(n); }
+        void clear() { borrowed = nullptr; borrowed_size = 0; owner.reset(); values.clear(); }
+};
+
+} // namespace
+
+#endif // COLUMN_H
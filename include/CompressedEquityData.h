@@ -0,0 +1,110 @@
+/**
+ * @file    CompressedEquityData.h
+ * @brief   Defines the CompressedEquityData class, a compressed copy of a HistoricalEquityData.
+ *
+ * Rows are cut into blocks of COMPRESSED_BLOCK_ROWS. Inside a block each column is
+ * encoded on its own: datetimes as delta-of-delta, prices as deltas of integer ticks
+ * and volumes as plain values, all written as zigzag varints. Blocks are decoded one at a
+ * time into a reusable DecodedBlock, so a backtest only ever holds one block of raw
+ * columns in memory.
+ *
+ * @author  Benny Zaionz
+ * @date    2026-10-18
+ * @version 1.0
+ */
+
+#ifndef COMPRESSED_EQUITY_DATA_H
+#define COMPRESSED_EQUITY_DATA_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "HistoricalEquityData.h"
+
+namespace AlgoTrading
+{
+
+const int COMPRESSED_BLOCK_ROWS = 4096;
+const std::int64_t DEFAULT_TICKS_PER_UNIT = 10000; // 0.0001 USD ticks
+
+struct DecodedBlock
+{
+    /*
+    one block of raw columns, reused between decodeBlock calls so that
+    decoding does not allocate once the vectors have grown
+    */
+    std::vector<DateTime> datetimes;
+    std::vector<double> last;
+    std::vector<double> low;
+    std::vector<double> high;
+    std::vector<double> bid;
+    std::vector<double> ask;
+    std::vector<int> volume;
+
+    // decoding scratch
+    std::vector<std::int64_t> last_ticks;
+    std::vector<std::int64_t> ticks;
+
+    int size() const { return datetimes.size(); }
+};
+
+class CompressedEquityData
+{
+    private:
+
+        struct BlockInfo
+        {
+            std::size_t offset; // into bytes
+            int num_rows;
+            DateTime first;
+            DateTime last;
+        };
+
+        const SymbolId symbol;
+        const int step_unit;
+        const int step_length;
+        const std::int64_t ticks_per_unit;
+
+        std::vector<std::uint8_t> bytes;
+        std::vector<BlockInfo> blocks;
+        int num_rows;
+        bool lossless; // every price was a whole number of ticks
+
+        void encodeBlock(const HistoricalEquityData& hist, const int first, const int count);
+
+    public:
+
+        /*---------- CONSTRUCTOR ----------*/
+
+        // prices are rounded to 1 / ticks_per_unit_, check isLossless() if that matters
+        CompressedEquityData(const HistoricalEquityData& hist, const std::int64_t ticks_per_unit_ = DEFAULT_TICKS_PER_UNIT);
+
+        /*---------- GETTERS ----------*/
+
+        SymbolId getSymbol() const { return symbol; }
+        const std::string& getTicker() const { return symbolTicker(symbol); }
+        int getStepUnit() const { return step_unit; }
+        int getStepLength() const { return step_length; }
+        std::int64_t getTicksPerUnit() const { return ticks_per_unit; }
+
+        int getSize() const { return num_rows; }
+        int getNumBlocks() const { return blocks.size(); }
+        int getBlockSize(const int block) const { return blocks[block].num_rows; }
+        DateTime getBlockFirst(const int block) const { return blocks[block].first; }
+        DateTime getBlockLast(const int block) const { return blocks[block].last; }
+
+        std::size_t getCompressedBytes() const { return bytes.size() + blocks.size() * sizeof(BlockInfo); }
+        std::size_t getRawBytes() const; // size of the same rows as HistoricalEquityData columns
+        double getCompressionRatio() const { return double(getRawBytes()) / double(getCompressedBytes()); }
+        bool isLossless() const { return lossless; }
+
+        /*---------- DECODING ----------*/
+
+        void decodeBlock(const int block, DecodedBlock& out) const;
+        HistoricalEquityData decompress() const;
+};
+
+} // namespace
+
+#endif // COMPRESSED_EQUITY_DATA_H
@@ -0,0 +1,68 @@
+/**
+ * @file    CsvLoader.h
+ * @brief   Defines the CsvLoader class which loads bar CSV files into HistoricalEquityData.
+ *
+ * This file contains the declaration of the CsvLoader class and the CsvLoadStats it
+ * reports. A file is memory mapped, split into newline aligned chunks which are parsed
+ * on separate threads, and the chunks are appended to the HistoricalEquityData in file
+ * order. Each row is "datetime,last,low,high,bid,ask,volume" where datetime is
+ * "YYYYMMDD" or "YYYYMMDD hh:mm:ss" and trailing fields may be left out (they take the
+ * EquitySnapshot defaults). Rows with a full timestamp are stored as given, rows with
+ * only a date go through append_data's intraday time inference. A first line that does
+ * not start with a digit is treated as a header and skipped.
+ *
+ * @author  Benny Zaionz
+ * @date    2026-10-18
+ * @version 1.0
+ */
+
+#ifndef CSV_LOADER_H
+#define CSV_LOADER_H
+
+#include <string>
+
+#include "HistoricalEquityData.h"
+
+namespace AlgoTrading
+{
+
+struct CsvLoadStats
+{
+    long long rows = 0;          // rows appended
+    long long rows_skipped = 0;  // malformed rows
+    long long bytes = 0;
+    int threads = 0;
+    double read_seconds = 0;     // faulting the file into memory, i.e. disk (or page cache) speed
+    double parse_seconds = 0;    // parsing on all threads
+    double merge_seconds = 0;    // appending the parsed chunks in order
+
+    double totalSeconds() const { return read_seconds + parse_seconds + merge_seconds; }
+    double rowsPerSec() const { return totalSeconds() > 0 ? rows / totalSeconds() : 0; }
+    double mbPerSec() const { return totalSeconds() > 0 ? bytes / 1e6 / totalSeconds() : 0; }
+    double readMbPerSec() const { return read_seconds > 0 ? bytes / 1e6 / read_seconds : 0; }
+    double parseMbPerSec() const { return parse_seconds > 0 ? bytes / 1e6 / parse_seconds : 0; }
+
+    void print() const;
+};
+
+class CsvLoader
+{
+    private:
+
+        const int num_threads; // 0 uses std::thread::hardware_concurrency()
+
+    public:
+
+        /*---------- CONSTRUCTOR ----------*/
+
+        CsvLoader(const int num_threads_ = 0);
+
+        /*---------- LOADING ----------*/
+
+        // appends every row of the file to hist, throws std::runtime_error if the file cannot be opened
+        CsvLoadStats load(const std::string& path, HistoricalEquityData& hist) const;
+};
+
+} // namespace
+
+#endif // CSV_LOADER_H
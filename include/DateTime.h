@@ -2,77 +2,143 @@
  * @file    DateTime.h
  * @brief   Defines the DateTime class.
  *
- * This file contains the declaration of the DateTime class, which stores year,
- * month, day, hour, minute, and second. It is intended to be used by the EquitySnapshot 
- * class. 
+ * This file contains the declaration of the DateTime class, which stores a point
+ * in time as a single count of seconds since 1970-01-01 00:00:00 UTC. Year, month,
+ * day, hour, minute, and second are derived from it with constexpr civil-date
+ * arithmetic, so results never depend on the local timezone. It is intended to be
+ * used by the EquitySnapshot class.
  *
  * @author  Benny Zaionz
  * @date    2025-06-19
- * @version 1.0
+ * @version 2.0
  */
 
  #ifndef DATETIME_H
  #define DATETIME_H
 
+ #include <cstddef>
+ #include <cstdint>
+ #include <span>
  #include <string>
- #include <ctime>
+ #include <string_view>
 
 namespace AlgoTrading
 {
 
+const std::int64_t SECONDS_PER_DAY = 86400;
+
 class DateTime
 {
 
     private:
 
-        int year;
-        int month;
-        int day;
-        int hour;
-        int min;
-        int sec;
+        std::int64_t epoch; // seconds since 1970-01-01 00:00:00 UTC
+
+        /*---------- CIVIL DATE CONVERSION ----------*/
+
+        // proleptic Gregorian calendar, valid for any year representable in an int
+        static constexpr std::int64_t daysFromCivil(int year_, const int month_, const int day_)
+        {
+            year_ -= month_ <= 2;
+            const std::int64_t era = (year_ >= 0 ? year_ : year_ - 399) / 400;
+            const std::int64_t yoe = year_ - era * 400;                                 // [0, 399]
+            const std::int64_t doy = (153 * (month_ > 2 ? month_ - 3 : month_ + 9) + 2) / 5 + day_ - 1; // [0, 365]
+            const std::int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;            // [0, 146096]
+            return era * 146097 + doe - 719468;
+        }
+
+        static constexpr void civilFromDays(std::int64_t days, int& year_, int& month_, int& day_)
+        {
+            days += 719468;
+            const std::int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+            const std::int64_t doe = days - era * 146097;                               // [0, 146096]
+            const std::int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365; // [0, 399]
+            const std::int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);           // [0, 365]
+            const std::int64_t mp = (5 * doy + 2) / 153;                                // [0, 11]
+            day_ = static_cast<int>(doy - (153 * mp + 2) / 5 + 1);
+            month_ = static_cast<int>(mp < 10 ? mp + 3 : mp - 9);
+            year_ = static_cast<int>(yoe + era * 400 + (month_ <= 2));
+        }
+
+        static constexpr std::int64_t floorDiv(const std::int64_t a, const std::int64_t b)
+        {
+            return a / b - ((a % b != 0) && ((a < 0) != (b < 0)));
+        }
 
     public:
 
         /*---------- CONSTRUCTORS ----------*/
 
-        DateTime(const std::string& datetime_);
+        DateTime(const std::string& datetime_); // throws std::invalid_argument if parse() fails
+
+        // hour, min and sec may be outside their usual range and roll over into the date
+        constexpr DateTime(const int year_ = 2000,
+                           const int month_ = 1,
+                           const int day_ = 1,
+                           const int hour_ = 0,
+                           const int min_ = 0,
+                           const int sec_ = 0):
+            epoch(daysFromCivil(year_, month_, day_) * SECONDS_PER_DAY
+                  + std::int64_t(hour_) * 3600 + std::int64_t(min_) * 60 + sec_) {}
+
+        static constexpr DateTime fromEpoch(const std::int64_t epoch_)
+        {
+            DateTime datetime_;
+            datetime_.epoch = epoch_;
+            return datetime_;
+        }
+
+        /*---------- PARSING ----------*/
+
+        // parses "YYYYMMDD" or "YYYYMMDD hh:mm:ss" without allocating, returns false if the
+        // text is not exactly one of those formats or is not a valid calendar date and time
+        static bool parse(std::string_view text, DateTime& out);
+
+        // parses texts[i] into out[i] until the first invalid entry, returns the number parsed,
+        // 17 character timestamps are converted with SSE4.1 when the build enables it
+        static std::size_t parseBatch(std::span<const std::string_view> texts, std::span<DateTime> out);
 
-        DateTime(const int year_ = 2000,
-                 const int month_ = 1,
-                 const int day_ = 1,
-                 const int hour_ = 0,
-                 const int min_ = 0,
-                 const int sec_ = 0);
-        
         /*---------- GETTERS ----------*/
-        
-        int getYear() const { return year; }
-        int getMonth() const { return month; }
-        int getDay() const { return day; }
-        int getHour() const { return hour; }
-        int getMin() const { return min; }
-        int getSec() const { return sec; }  
+
+        constexpr std::int64_t getEpoch() const { return epoch; }
+        constexpr std::int64_t getEpochDay() const { return floorDiv(epoch, SECONDS_PER_DAY); } // days since 1970-01-01
+        constexpr int getSecondOfDay() const { return static_cast<int>(epoch - getEpochDay() * SECONDS_PER_DAY); }
+
+        constexpr int getYear() const { int y = 0, m = 0, d = 0; civilFromDays(getEpochDay(), y, m, d); return y; }
+        constexpr int getMonth() const { int y = 0, m = 0, d = 0; civilFromDays(getEpochDay(), y, m, d); return m; }
+        constexpr int getDay() const { int y = 0, m = 0, d = 0; civilFromDays(getEpochDay(), y, m, d); return d; }
+        constexpr int getHour() const { return getSecondOfDay() / 3600; }
+        constexpr int getMin() const { return getSecondOfDay() % 3600 / 60; }
+        constexpr int getSec() const { return getSecondOfDay() % 60; }
 
 
         /*---------- SETTERS ----------*/
 
-        void setYear(int year_) { year = year_; }
-        void setMonth(int month_) { month = month_; }
-        void setDay(int day_) { day = day_; }
-        void setHour(int hour_) { hour = hour_; }
-        void setMin(int min_) { min = min_; }
-        void setSec(int sec_) { sec = sec_; }
+        constexpr void setYear(int year_) { *this = DateTime(year_, getMonth(), getDay(), getHour(), getMin(), getSec()); }
+        constexpr void setMonth(int month_) { *this = DateTime(getYear(), month_, getDay(), getHour(), getMin(), getSec()); }
+        constexpr void setDay(int day_) { *this = DateTime(getYear(), getMonth(), day_, getHour(), getMin(), getSec()); }
+        constexpr void setHour(int hour_) { epoch += std::int64_t(hour_ - getHour()) * 3600; }
+        constexpr void setMin(int min_) { epoch += std::int64_t(min_ - getMin()) * 60; }
+        constexpr void setSec(int sec_) { epoch += sec_ - getSec(); }
 
         /*---------- OPERATOR OVERLOAD ----------*/
 
-        DateTime operator+(const int secondsToAdd) const;
-        DateTime& operator+=(const int secondsToAdd);
-        bool operator==(const DateTime& datetime_);
+        // both operators roll over minutes, hours, days, months and years
+        constexpr DateTime operator+(const std::int64_t secondsToAdd) const { return fromEpoch(epoch + secondsToAdd); }
+        constexpr DateTime& operator+=(const std::int64_t secondsToAdd) { epoch += secondsToAdd; return *this; }
+        constexpr DateTime operator-(const std::int64_t secondsToSubtract) const { return fromEpoch(epoch - secondsToSubtract); }
+        constexpr std::int64_t operator-(const DateTime& datetime_) const { return epoch - datetime_.epoch; } // seconds between
+
+        constexpr bool operator==(const DateTime& datetime_) const { return epoch == datetime_.epoch; }
+        constexpr bool operator!=(const DateTime& datetime_) const { return epoch != datetime_.epoch; }
+        constexpr bool operator<(const DateTime& datetime_) const { return epoch < datetime_.epoch; }
+        constexpr bool operator>(const DateTime& datetime_) const { return epoch > datetime_.epoch; }
+        constexpr bool operator<=(const DateTime& datetime_) const { return epoch <= datetime_.epoch; }
+        constexpr bool operator>=(const DateTime& datetime_) const { return epoch >= datetime_.epoch; }
 
         /*---------- COMPARISONS ----------*/
 
-        bool sameDateAs(const DateTime& datetime_) const;
+        constexpr bool sameDateAs(const DateTime& datetime_) const { return getEpochDay() == datetime_.getEpochDay(); }
 
         /*---------- PRINT HELPERS ----------*/
 
@@ -82,4 +148,4 @@ class DateTime
 
 } // end namespace
 
- #endif
\ No newline at end of file
+ #endif
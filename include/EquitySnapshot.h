@@ -5,7 +5,8 @@
  * This file contains the declaration of the EquitySnapshot class, which stores OHLC prices,
  * bid/ask prices, last traded price, and timestamp information for an equity at a 
  * specific point in time. It is used by the AlgoTrading system for both backtesting 
- * and live trading data processing.
+ * and live trading data processing. Prices are stored as fixed-point Price values,
+ * the double getters and setters convert at the edge and keep -1 for a missing price.
  *
  * @author  Benny Zaionz
  * @date    2025-06-18
@@ -18,6 +19,7 @@
 
 #include <string>
 #include "DateTime.h"
+#include "FixedPoint.h"
 
 namespace AlgoTrading
 {
@@ -31,11 +33,11 @@ class EquitySnapshot
 
         DateTime dt;
         // std::string datetime;
-        double last;
-        double low;
-        double high;
-        double bid;
-        double ask;
+        Price last; // Price::missing() where the data has no price
+        Price low;
+        Price high;
+        Price bid;
+        Price ask;
         int volume;
 
     public:
@@ -63,14 +65,22 @@ class EquitySnapshot
         
         // std::string getDatetime() const { return datetime; }
         DateTime getDatetime() const { return dt; }
-        double getLast() const { return last; }
-        double getLow() const { return low; }
-        double getHigh() const { return high; }
-        double getBid() const { return bid; }
-        double getAsk() const { return ask; }
+        double getLast() const { return last.toPrice(); } // -1 if missing
+        double getLow() const { return low.toPrice(); }
+        double getHigh() const { return high.toPrice(); }
+        double getBid() const { return bid.toPrice(); }
+        double getAsk() const { return ask.toPrice(); }
         int getVolume() const { return volume; }
         double getPrice(const int price_type = LAST) const;
 
+        // exact fixed-point prices, Price::missing() instead of -1
+        Price getLastPrice() const { return last; }
+        Price getLowPrice() const { return low; }
+        Price getHighPrice() const { return high; }
+        Price getBidPrice() const { return bid; }
+        Price getAskPrice() const { return ask; }
+        Price getFixedPrice(const int price_type = LAST) const;
+
 
         
         /* ---------- SETTERS ---------*/
@@ -78,11 +88,16 @@ class EquitySnapshot
         // void setDateTime(const std::string& datetime_) { datetime = datetime_; }
         void setDatetime(const DateTime& datetime_) { dt = datetime_; }
         void setDatetime(const std::string& datetime_) { dt = DateTime(datetime_); }
-        void setLast(const double last_) { last = last_; }
-        void setLow(const double low_) { low = low_; }
-        void setHigh(const double high_) { high = high_; }
-        void setBid(const double avg_bid_) { bid = avg_bid_; }
-        void setAsk(const double avg_ask_) { ask = avg_ask_; }
+        void setLast(const double last_) { last = Price::fromPrice(last_); } // rounded to the nearest tick, -1 means missing
+        void setLow(const double low_) { low = Price::fromPrice(low_); }
+        void setHigh(const double high_) { high = Price::fromPrice(high_); }
+        void setBid(const double avg_bid_) { bid = Price::fromPrice(avg_bid_); }
+        void setAsk(const double avg_ask_) { ask = Price::fromPrice(avg_ask_); }
+        void setLast(const Price last_) { last = last_; }
+        void setLow(const Price low_) { low = low_; }
+        void setHigh(const Price high_) { high = high_; }
+        void setBid(const Price bid_) { bid = bid_; }
+        void setAsk(const Price ask_) { ask = ask_; }
         void setVolume(const int volume_) { volume = volume_; }
         
         /*---------- PRINT HELPER ----------*/
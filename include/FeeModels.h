@@ -0,0 +1,196 @@
+/**
+ * @file    FeeModels.h
+ * @brief   Defines the commission and fee models a Portfolio can be compiled with.
+ *
+ * This file contains the FeeModel concept and the models that satisfy it. A model is a
+ * small value type with a commission(side, quantity, price) member returning Money.
+ * BasicPortfolio takes the model as a template parameter, so the commission of every fill
+ * is an inlined call rather than a virtual one. Models compose: CappedFees limits another
+ * model to a share of the trade value and CombinedFees adds several together.
+ * evaluateFees computes the fees of a whole column of trades in one loop.
+ *
+ * All arithmetic is in fixed-point ticks, rates below one tick per share (FINRA TAF, SEC
+ * fee) are kept as integer ratios and rounded once per trade.
+ *
+ * @author  Benny Zaionz
+ * @date    2026-10-18
+ * @version 1.0
+ */
+
+#ifndef FEE_MODELS_H
+#define FEE_MODELS_H
+
+#include <concepts>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+
+#include "FixedPoint.h"
+
+namespace AlgoTrading
+{
+
+enum OrderSide{ BUY, SELL };
+
+const double COMMISSION_PER_SHARE = 0.005; // from IBKR pro trading license: https://www.interactivebrokers.com/en/pricing/commissions-stocks.php
+const int MIN_COMMISSION = 1; // also from IBKR pro trading license, any commission price less than 1 will round up to 1
+
+// the same fees in ticks, all accounting below is exact fixed-point arithmetic
+const Money COMMISSION_PER_SHARE_FIXED = Money::fromDouble(COMMISSION_PER_SHARE);
+const Money MIN_COMMISSION_FIXED = Money::fromUnits(MIN_COMMISSION);
+
+/*---------- CONCEPT ----------*/
+
+template<typename F>
+concept FeeModel = requires(const F& fees, const int side, const int quantity, const Price price)
+{
+    { fees.commission(side, quantity, price) } -> std::same_as<Money>;
+};
+
+/*---------- MODELS ----------*/
+
+struct ZeroFees
+{
+    // for research runs that should ignore costs
+    Money commission(const int, const int, const Price) const { return Money(); }
+};
+
+struct IbkrFixedFees
+{
+    // the original Portfolio pricing, COMMISSION_PER_SHARE with a MIN_COMMISSION floor
+    Money commission(const int, const int quantity, const Price) const
+    {
+        Money fee = COMMISSION_PER_SHARE_FIXED * quantity;
+
+        if( fee <= MIN_COMMISSION_FIXED )
+            return MIN_COMMISSION_FIXED;
+
+        return fee;
+    }
+};
+
+struct IbkrTieredFees
+{
+    /*
+    IBKR Pro tiered US stock pricing: the per share rate falls with the shares traded this month,
+    at least 0.35 per order and at most 1% of the trade value, exchange and regulatory fees are
+    separate (see ExchangeFees and RegulatoryFees)
+    */
+    std::int64_t monthly_shares = 0; // shares traded so far this month, set by the caller
+
+    static constexpr Money MINIMUM = Money::fromDouble(0.35);
+    static constexpr int MAX_PERCENT_OF_VALUE = 1;
+
+    constexpr Money perShare() const
+    {
+        if( monthly_shares <= 300000 )
+            return Money::fromDouble(0.0035);
+        else if( monthly_shares <= 3000000 )
+            return Money::fromDouble(0.002);
+        else if( monthly_shares <= 20000000 )
+            return Money::fromDouble(0.0015);
+        else if( monthly_shares <= 100000000 )
+            return Money::fromDouble(0.001);
+
+        return Money::fromDouble(0.0005);
+    }
+
+    Money commission(const int, const int quantity, const Price price) const
+    {
+        Money fee = perShare() * quantity;
+
+        if( fee < MINIMUM )
+            fee = MINIMUM;
+
+        const Money cap = (price * quantity).scaledBy(MAX_PERCENT_OF_VALUE, 100);
+
+        return fee < cap ? fee : cap;
+    }
+};
+
+struct ExchangeFees
+{
+    Money per_share = Money::fromDouble(0.003); // the usual take fee cap for removing liquidity on US exchanges
+
+    Money commission(const int, const int quantity, const Price) const { return per_share * quantity; }
+};
+
+struct RegulatoryFees
+{
+    /*
+    charged on sales only, the SEC Section 31 fee on the trade value and the FINRA trading
+    activity fee per share, both rates are revised every year so they are members
+    */
+    Money sec_per_million = Money::fromDouble(27.80); // per 1,000,000 of value sold
+    std::int64_t taf_micros_per_share = 166; // 0.000166 per share sold
+    Money taf_maximum = Money::fromDouble(8.30);
+
+    Money commission(const int side, const int quantity, const Price price) const
+    {
+        if( side != SELL )
+            return Money();
+
+        const Money sec = (price * quantity).scaledBy(sec_per_million.getTicks(), Money::TICKS_PER_UNIT * 1000000);
+        Money taf = Money::fromUnits(quantity).scaledBy(taf_micros_per_share, 1000000);
+
+        if( taf > taf_maximum )
+            taf = taf_maximum;
+
+        return sec + taf;
+    }
+};
+
+template<FeeModel Base>
+struct CappedFees
+{
+    // Base's fees, but never more than cap_bps basis points of the trade value
+    Base base = Base();
+    std::int64_t cap_bps = 100;
+
+    Money commission(const int side, const int quantity, const Price price) const
+    {
+        const Money fee = base.commission(side, quantity, price);
+        const Money cap = (price * quantity).scaledBy(cap_bps, 10000);
+
+        return fee < cap ? fee : cap;
+    }
+};
+
+template<FeeModel... Models>
+struct CombinedFees
+{
+    // the sum of every model, e.g. commission plus exchange plus regulatory fees
+    std::tuple<Models...> models = std::tuple<Models...>();
+
+    Money commission(const int side, const int quantity, const Price price) const
+    {
+        return std::apply([&](const Models&... model) { return (Money() + ... + model.commission(side, quantity, price)); }, models);
+    }
+};
+
+using IbkrTieredAllInFees = CombinedFees<IbkrTieredFees, ExchangeFees, RegulatoryFees>;
+
+/*---------- BATCH EVALUATION ----------*/
+
+// out[i] = fees.commission(sides[i], quantities[i], prices[i]), every span must be as long as sides
+template<FeeModel Fees>
+void evaluateFees(const Fees& fees,
+                  std::span<const int> sides,
+                  std::span<const int> quantities,
+                  std::span<const Price> prices,
+                  std::span<Money> out)
+{
+    const std::size_t count = sides.size();
+
+    if( quantities.size() != count || prices.size() != count || out.size() < count )
+        throw std::invalid_argument("evaluateFees needs columns of the same length");
+
+    // one tight loop over plain columns, the model is inlined so simple ones vectorize
+    for( std::size_t i = 0; i < count; i++ )
+        out[i] = fees.commission(sides[i], quantities[i], prices[i]);
+}
+
+} // namespace
+
+#endif // FEE_MODELS_H
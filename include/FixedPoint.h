@@ -0,0 +1,107 @@
+/**
+ * @file    FixedPoint.h
+ * @brief   Defines the FixedPoint class and the Price and Money types built on it.
+ *
+ * This file contains the declaration of FixedPoint, a signed 64 bit count of ticks with
+ * a compile-time number of ticks per unit (dollar). Sums, differences and products with
+ * share counts are exact integer arithmetic, so accounting gives the same result on
+ * every compiler and can be reconciled to the tick. Doubles are only used at the edges
+ * (fromDouble / toDouble). A dedicated missing() value replaces the -1 "no data" price.
+ *
+ * The tick size defaults to 0.0001 and can be changed by defining
+ * ALGOTRADING_TICKS_PER_UNIT before including this header (or on the command line).
+ *
+ * @author  Benny Zaionz
+ * @date    2026-10-18
+ * @version 1.0
+ */
+
+#ifndef FIXED_POINT_H
+#define FIXED_POINT_H
+
+#include <cstdint>
+#include <limits>
+
+#ifndef ALGOTRADING_TICKS_PER_UNIT
+#define ALGOTRADING_TICKS_PER_UNIT 10000
+#endif
+
+namespace AlgoTrading
+{
+
+template<std::int64_t TicksPerUnit>
+class FixedPoint
+{
+    private:
+
+        std::int64_t ticks;
+
+        static constexpr std::int64_t MISSING = std::numeric_limits<std::int64_t>::min();
+
+    public:
+
+        static constexpr std::int64_t TICKS_PER_UNIT = TicksPerUnit;
+
+        /*---------- CONSTRUCTORS ----------*/
+
+        constexpr FixedPoint(): ticks(0) {}
+
+        static constexpr FixedPoint fromTicks(const std::int64_t ticks_) { FixedPoint f; f.ticks = ticks_; return f; }
+        static constexpr FixedPoint fromUnits(const std::int64_t units) { return fromTicks(units * TicksPerUnit); }
+        static constexpr FixedPoint missing() { return fromTicks(MISSING); }
+
+        // rounds to the nearest tick, half away from zero
+        static constexpr FixedPoint fromDouble(const double value)
+        {
+            const double scaled = value * static_cast<double>(TicksPerUnit);
+            return fromTicks(static_cast<std::int64_t>(scaled >= 0 ? scaled + 0.5 : scaled - 0.5));
+        }
+
+        // the -1 sentinel used by EquitySnapshot becomes missing()
+        static constexpr FixedPoint fromPrice(const double price) { return price == -1 ? missing() : fromDouble(price); }
+
+        /*---------- GETTERS ----------*/
+
+        constexpr std::int64_t getTicks() const { return ticks; }
+        constexpr bool isMissing() const { return ticks == MISSING; }
+
+        // division (not multiplication by the tick size) gives back exactly the double that was rounded in
+        constexpr double toDouble() const { return static_cast<double>(ticks) / static_cast<double>(TicksPerUnit); }
+        constexpr double toPrice() const { return isMissing() ? -1 : toDouble(); } // missing() back to -1
+
+        /*---------- ARITHMETIC ----------*/
+
+        constexpr FixedPoint operator+(const FixedPoint other) const { return fromTicks(ticks + other.ticks); }
+        constexpr FixedPoint operator-(const FixedPoint other) const { return fromTicks(ticks - other.ticks); }
+        constexpr FixedPoint operator-() const { return fromTicks(-ticks); }
+        constexpr FixedPoint operator*(const std::int64_t quantity) const { return fromTicks(ticks * quantity); }
+        constexpr FixedPoint& operator+=(const FixedPoint other) { ticks += other.ticks; return *this; }
+        constexpr FixedPoint& operator-=(const FixedPoint other) { ticks -= other.ticks; return *this; }
+
+        // this * numerator / denominator, rounded half away from zero (e.g. a fee of 5 basis points is scaledBy(5, 10000))
+        constexpr FixedPoint scaledBy(const std::int64_t numerator, const std::int64_t denominator) const
+        {
+            const std::int64_t product = ticks * numerator;
+            const std::int64_t half = denominator / 2;
+            return fromTicks(product >= 0 ? (product + half) / denominator : (product - half) / denominator);
+        }
+
+        /*---------- COMPARISONS ----------*/
+
+        constexpr bool operator==(const FixedPoint other) const { return ticks == other.ticks; }
+        constexpr bool operator!=(const FixedPoint other) const { return ticks != other.ticks; }
+        constexpr bool operator<(const FixedPoint other) const { return ticks < other.ticks; }
+        constexpr bool operator>(const FixedPoint other) const { return ticks > other.ticks; }
+        constexpr bool operator<=(const FixedPoint other) const { return ticks <= other.ticks; }
+        constexpr bool operator>=(const FixedPoint other) const { return ticks >= other.ticks; }
+};
+
+template<std::int64_t TicksPerUnit>
+constexpr FixedPoint<TicksPerUnit> operator*(const std::int64_t quantity, const FixedPoint<TicksPerUnit> value) { return value * quantity; }
+
+using Price = FixedPoint<ALGOTRADING_TICKS_PER_UNIT>; // per share
+using Money = FixedPoint<ALGOTRADING_TICKS_PER_UNIT>; // cash, values and fees
+
+} // namespace
+
+#endif // FIXED_POINT_H
@@ -1,16 +1,22 @@
 /*
 This files defines the HistoricalMarketData class which contains data about a stock over time
-It contains a vector of MarketSnapshots defined in Market_Snapshot.h
+The data is stored column by column (one contiguous Column per field), rows can be read
+through the SnapshotRef proxy or copied out as EquitySnapshots
 */
 
 #ifndef HISTORICAL_EQUITY_DATA_H
 #define HISTORICAL_EQUITY_DATA_H
 
+#include <iterator>
+#include <span>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+#include "Column.h"
 #include "EquitySnapshot.h"
 #include "LiveEquity.h"
+#include "SymbolTable.h"
 
 namespace AlgoTrading
 {
@@ -19,60 +25,317 @@ enum StepSizeUnit{ SECS, MINS, HOURS, DAYS, WEEKS, MONTHS };
 
 const int NOT_CONTAINED = -1;
 
+class HistoricalEquityData;
+class HistoricalEquityView;
+
+struct IndexRange
+{
+    /*
+    half-open range [begin, end) of positions in chronological order,
+    positions are row indices whenever isChronological() is true
+    */
+    int begin;
+    int end;
+
+    int size() const { return end - begin; }
+    bool empty() const { return end <= begin; }
+};
+
+/*---------- ROW PROXY ----------*/
+
+class SnapshotRef
+{
+    /*
+    lightweight read-only view of one row of a HistoricalEquityData,
+    only valid while the HistoricalEquityData it came from is alive and unmodified
+    */
+
+    private:
+
+        const HistoricalEquityData* hist;
+        int index;
+
+    public:
+
+        SnapshotRef(const HistoricalEquityData& hist_, const int index_): hist(&hist_), index(index_) {}
+
+        /*---------- GETTERS ----------*/
+
+        int getIndex() const { return index; }
+        DateTime getDatetime() const;
+        double getLast() const;
+        double getLow() const;
+        double getHigh() const;
+        double getBid() const;
+        double getAsk() const;
+        int getVolume() const;
+        double getPrice(const int price_type = LAST) const;
+
+        EquitySnapshot toSnapshot() const;
+        operator EquitySnapshot() const { return toSnapshot(); }
+
+        /*---------- PRINT HELPER ----------*/
+
+        void print(const int print_type = BID_ASK) const { toSnapshot().print(print_type); }
+};
+
 class HistoricalEquityData
 {
     private:
 
-        const std::string ticker;
-        std::vector<EquitySnapshot> data;
+        const SymbolId symbol;
+        Column<DateTime> datetimes;
+        Column<double> last;
+        Column<double> low;
+        Column<double> high;
+        Column<double> bid;
+        Column<double> ask;
+        Column<int> volume;
         const int step_unit; // enum
         const int step_length;
 
-        /*---------- SETTERS ----------*/
+        // row indices sorted by datetime, left empty while rows are appended in chronological order
+        std::vector<int> time_index;
+
+        /*---------- TIMESTAMP INDEX ----------*/
 
-        void setData(std::vector<EquitySnapshot> ms) { data = ms; }
+        void indexDatetime(const int index); // called by append_data after a row is pushed
+        void rebuildTimeIndex();
+        int lowerPosition(const DateTime& datetime_) const; // first position with datetime >= datetime_
+        int upperPosition(const DateTime& datetime_) const; // first position with datetime > datetime_
+
+        // running count of rows per date (keyed by days since epoch), covers the first counted_rows rows,
+        // an inferred row counts under the date it was given even when its timestamp rolled past midnight
+        std::unordered_map<std::int64_t, int> date_counts;
+        int counted_rows;
 
         /*---------- DATETIME HANDLER ----------*/
 
+        static std::int64_t dateKey(const DateTime& datetime_) { return datetime_.getEpochDay(); }
+        void syncDateCounts(); // brings date_counts up to date with every stored row
         int countDate(const DateTime& datetime_) const; // returns the number of times a date is present in list of datetimes
         DateTime datetimeHandler(const DateTime& datetime_) const;
+        void growFor(const int num_rows); // geometric reserve ahead of a bulk append
 
     public:
 
-    HistoricalEquityData(const std::string& ticker_,
-                         const int step_unit_ = DAYS, 
+    HistoricalEquityData(const std::string& ticker_, // interns ticker_
+                         const int step_unit_ = DAYS,
+                         const int step_length_ = 1);
+
+    HistoricalEquityData(const SymbolId symbol_,
+                         const int step_unit_ = DAYS,
                          const int step_length_ = 1);
 
     /*---------- GETTERS ----------*/
 
-    std::string getTicker() const { return ticker; }
+    SymbolId getSymbol() const { return symbol; }
+    const std::string& getTicker() const { return symbolTicker(symbol); }
 
-    std::vector<EquitySnapshot> getData() const { return data; }
+    std::vector<EquitySnapshot> getData() const; // copies every row, prefer the column views or getRow()
     std::vector<DateTime> getDatetimes() const;
     std::vector<double> getHistoricalPrices(const int price_type) const;
     std::vector<int> getHistoricalVolume() const;
 
     int getStepUnit() const { return step_unit; }
     int getStepLength() const { return step_length; }
-    int getSize() const { return data.size(); } // returns the size of the data vector (number of Equity snapshots)
-    EquitySnapshot getSnapshotAt(std::string& datetime_) const;
+    int getSize() const { return datetimes.size(); } // returns the number of rows (number of Equity snapshots)
+    EquitySnapshot getSnapshotAt(const std::string& datetime_) const;
+    EquitySnapshot getSnapshotAt(const DateTime& datetime_) const;
+
+    /*---------- COLUMN VIEWS ----------*/
+
+    // non-owning views, invalidated by append_data
+    std::span<const DateTime> getDatetimeColumn() const { return datetimes.view(); }
+    std::span<const double> getPriceColumn(const int price_type = LAST) const; // empty span for an unknown price_type
+    std::span<const int> getVolumeColumn() const { return volume.view(); }
+
+    /*---------- ROW ACCESS ----------*/
+
+    SnapshotRef getRow(const int index) const { return SnapshotRef(*this, index); }
+    SnapshotRef operator[](const int index) const { return SnapshotRef(*this, index); }
 
     /*---------- APPENDING DATA ----------*/
 
-    void append_data(const EquitySnapshot& eq); // { data.push_back(eq); }
-    void append_data(const LiveEquity& leq); // { data.push_back(leq.getCurrentSnapshot()); }
+    // every append infers intraday times from the date in O(1), see datetimeHandler
+    void append_data(const EquitySnapshot& eq);
+    void append_data(const LiveEquity& leq);
+    void append_data(std::span<const EquitySnapshot> snapshots);
+
+    template<typename InputIt>
+    void append_data(InputIt first, InputIt last);
+
+    // stores the datetime as given, for rows that already carry their intraday time
+    void append_exact(const EquitySnapshot& eq);
+    void append_exact(std::span<const EquitySnapshot> snapshots);
+    void append_columns(std::span<const DateTime> datetimes_, // every span must have the same length
+                        std::span<const double> last_,
+                        std::span<const double> low_,
+                        std::span<const double> high_,
+                        std::span<const double> bid_,
+                        std::span<const double> ask_,
+                        std::span<const int> volume_);
+
+    void reserve(const int num_rows);
+
+
+    /*---------- SAVING AND LOADING ----------*/
+
+    // binary bar file, see BarFile.h, both throw std::runtime_error on failure
+    // writes path + ".tmp" and renames it over path, mappings of the old file stay valid on POSIX,
+    // on Windows the rename fails while path is still mapped by a loaded HistoricalEquityData
+    void save(const std::string& path) const;
+    static HistoricalEquityData load(const std::string& path); // memory maps the file, columns are not copied until appended to
 
-    
     /*---------- PRINT HELPER ----------*/
-    
+
     void print(const int print_type = BID_ASK) const;
 
     /*---------- CHECK CONTENTS ----------*/
 
     int containsDatetime(const std::string& datetime_) const;
-    
+
+    /*---------- TIMESTAMP LOOKUPS ----------*/
+
+    // all lookups are binary searches over the datetime column and return row indices or NOT_CONTAINED
+    bool isChronological() const { return time_index.empty(); }
+    int getIndexByTime(const int position) const { return time_index.empty() ? position : time_index[position]; }
+
+    int findDatetime(const DateTime& datetime_) const; // exact match
+    int findAsOf(const DateTime& datetime_) const; // last bar at or before datetime_
+    IndexRange findRange(const DateTime& start, const DateTime& end) const; // bars with start <= datetime <= end
+
+    /*---------- RANGE VIEWS ----------*/
+
+    // non-owning, no allocation, invalidated by append_data like the column views
+    HistoricalEquityView getView(const int begin, const int end) const; // rows [begin, end), clamped to the data
+    HistoricalEquityView getRange(const DateTime& start, const DateTime& end) const; // rows with start <= datetime <= end, empty unless isChronological()
+
 };
 
+/*---------- RANGE VIEW ----------*/
+
+class HistoricalEquityView
+{
+    /*
+    contiguous rows [begin, end) of a HistoricalEquityData with the same
+    column and row accessors, row indices given to it are relative to begin
+    */
+
+    private:
+
+        const HistoricalEquityData* hist;
+        int first;
+        int count;
+
+    public:
+
+        HistoricalEquityView(const HistoricalEquityData& hist_, const int begin_, const int end_):
+            hist(&hist_), first(begin_), count(end_ > begin_ ? end_ - begin_ : 0) {}
+
+        /*---------- GETTERS ----------*/
+
+        SymbolId getSymbol() const { return hist->getSymbol(); }
+        const std::string& getTicker() const { return hist->getTicker(); }
+        int getStepUnit() const { return hist->getStepUnit(); }
+        int getStepLength() const { return hist->getStepLength(); }
+        int getSize() const { return count; }
+        bool empty() const { return count == 0; }
+        int getBegin() const { return first; } // row index in the parent
+        int getEnd() const { return first + count; }
+        const HistoricalEquityData& getParent() const { return *hist; }
+
+        std::vector<EquitySnapshot> getData() const;
+        std::vector<DateTime> getDatetimes() const;
+        std::vector<double> getHistoricalPrices(const int price_type) const;
+        std::vector<int> getHistoricalVolume() const;
+
+        /*---------- COLUMN VIEWS ----------*/
+
+        std::span<const DateTime> getDatetimeColumn() const { return hist->getDatetimeColumn().subspan(first, count); }
+        std::span<const double> getPriceColumn(const int price_type = LAST) const;
+        std::span<const int> getVolumeColumn() const { return hist->getVolumeColumn().subspan(first, count); }
+
+        /*---------- ROW ACCESS ----------*/
+
+        SnapshotRef getRow(const int index) const { return hist->getRow(first + index); }
+        SnapshotRef operator[](const int index) const { return hist->getRow(first + index); }
+
+        /*---------- SLICING ----------*/
+
+        HistoricalEquityView getView(const int begin, const int end) const;
+        HistoricalEquityView getRange(const DateTime& start, const DateTime& end) const;
+
+        /*---------- PRINT HELPER ----------*/
+
+        void print(const int print_type = BID_ASK) const;
+};
+
+/*---------- APPENDING DATA ----------*/
+
+template<typename InputIt>
+void HistoricalEquityData::append_data(InputIt first, InputIt last)
+{
+    if constexpr ( std::forward_iterator<InputIt> )
+        growFor(static_cast<int>(std::distance(first, last)));
+
+    for( ; first != last; ++first )
+        append_data(static_cast<const EquitySnapshot&>(*first));
+}
+
+/*---------- COLUMN VIEWS ----------*/
+
+inline std::span<const double> HistoricalEquityData::getPriceColumn(const int price_type) const
+{
+    if( price_type == LAST )
+        return last.view();
+    else if( price_type == LOW )
+        return low.view();
+    else if( price_type == HIGH )
+        return high.view();
+    else if( price_type == BID )
+        return bid.view();
+    else if( price_type == ASK )
+        return ask.view();
+
+    return {};
+}
+
+inline std::span<const double> HistoricalEquityView::getPriceColumn(const int price_type) const
+{
+    std::span<const double> prices = hist->getPriceColumn(price_type);
+
+    if( prices.empty() )
+        return {};
+
+    return prices.subspan(first, count);
+}
+
+/*---------- ROW PROXY GETTERS ----------*/
+
+inline DateTime SnapshotRef::getDatetime() const { return hist->getDatetimeColumn()[index]; }
+inline double SnapshotRef::getLast() const { return hist->getPriceColumn(LAST)[index]; }
+inline double SnapshotRef::getLow() const { return hist->getPriceColumn(LOW)[index]; }
+inline double SnapshotRef::getHigh() const { return hist->getPriceColumn(HIGH)[index]; }
+inline double SnapshotRef::getBid() const { return hist->getPriceColumn(BID)[index]; }
+inline double SnapshotRef::getAsk() const { return hist->getPriceColumn(ASK)[index]; }
+inline int SnapshotRef::getVolume() const { return hist->getVolumeColumn()[index]; }
+
+inline double SnapshotRef::getPrice(const int price_type) const
+{
+    std::span<const double> prices = hist->getPriceColumn(price_type);
+
+    if( prices.empty() )
+        return -1;
+
+    return prices[index];
+}
+
+inline EquitySnapshot SnapshotRef::toSnapshot() const
+{
+    return EquitySnapshot(getDatetime(), getLast(), getLow(), getHigh(), getBid(), getAsk(), getVolume());
+}
+
 } // namespace
 
-#endif // HISTORICAL_EQUITY_DATA_H
\ No newline at end of file
+#endif // HISTORICAL_EQUITY_DATA_H
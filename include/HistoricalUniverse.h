@@ -0,0 +1,105 @@
+/**
+ * @file    HistoricalUniverse.h
+ * @brief   Defines the HistoricalUniverse class, many tickers aligned on one time axis.
+ *
+ * This file contains the declaration of the HistoricalUniverse class. Every field is
+ * stored as one [time x symbol] matrix, row-major, with each time row padded to a whole
+ * number of cache lines. Reading every symbol at bar t is one contiguous row, reading
+ * one symbol's history is a strided column (or a transposed copy for heavy use). Bars
+ * a ticker does not have at a time on the axis are marked invalid, their prices are -1
+ * and their volume 0, the same defaults as EquitySnapshot.
+ *
+ * @author  Benny Zaionz
+ * @date    2026-10-18
+ * @version 1.0
+ */
+
+#ifndef HISTORICAL_UNIVERSE_H
+#define HISTORICAL_UNIVERSE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Column.h"
+#include "HistoricalEquityData.h"
+
+namespace AlgoTrading
+{
+
+template<typename T>
+struct StridedColumn
+{
+    /*
+    non-owning view of one column of a row-major matrix
+    */
+    const T* base;
+    std::size_t stride; // elements between consecutive rows
+    std::size_t count;
+
+    const T& operator[](const std::size_t i) const { return base[i * stride]; }
+    std::size_t size() const { return count; }
+};
+
+class HistoricalUniverse
+{
+    private:
+
+        std::vector<SymbolId> symbols;
+        std::unordered_map<SymbolId, int> symbol_index;
+        std::vector<DateTime> time_axis;
+        int stride; // symbols per row including padding
+
+        Column<double> last;
+        Column<double> low;
+        Column<double> high;
+        Column<double> bid;
+        Column<double> ask;
+        Column<int> volume;
+        Column<std::uint8_t> valid; // 1 where the ticker has a bar at that time
+
+        const Column<double>* priceMatrix(const int price_type) const;
+
+    public:
+
+        /*---------- CONSTRUCTOR ----------*/
+
+        // builds the master time axis as the union of every history's datetimes. Histories of the same ticker are
+        // merged into one column, every bar of each is kept and where two have a bar at the same time the later one wins
+        HistoricalUniverse(const std::vector<const HistoricalEquityData*>& histories);
+
+        /*---------- GETTERS ----------*/
+
+        int getNumTimes() const { return time_axis.size(); }
+        int getNumSymbols() const { return symbols.size(); }
+        int getStride() const { return stride; }
+        SymbolId getSymbol(const int symbol) const { return symbols[symbol]; }
+        const std::string& getTicker(const int symbol) const { return symbolTicker(symbols[symbol]); }
+        int getSymbolIndex(const SymbolId symbol_) const; // NOT_CONTAINED if missing
+        int getSymbolIndex(const std::string& ticker_) const { return getSymbolIndex(findSymbol(ticker_)); }
+        std::span<const DateTime> getTimeAxis() const { return time_axis; }
+        int findTime(const DateTime& datetime_) const; // exact match on the axis, NOT_CONTAINED if missing
+
+        /*---------- CROSS SECTION (ONE TIME, EVERY SYMBOL) ----------*/
+
+        std::span<const double> getPriceRow(const int price_type, const int t) const; // empty span for an unknown price_type
+        std::span<const int> getVolumeRow(const int t) const { return volume.view().subspan(std::size_t(t) * stride, getNumSymbols()); }
+        std::span<const std::uint8_t> getValidRow(const int t) const { return valid.view().subspan(std::size_t(t) * stride, getNumSymbols()); }
+        bool isValid(const int t, const int symbol) const { return valid[std::size_t(t) * stride + symbol] != 0; }
+
+        /*---------- HISTORY (ONE SYMBOL, EVERY TIME) ----------*/
+
+        StridedColumn<double> getPriceHistory(const int price_type, const int symbol) const;
+        StridedColumn<int> getVolumeHistory(const int symbol) const { return { volume.data() + symbol, std::size_t(stride), time_axis.size() }; }
+        StridedColumn<std::uint8_t> getValidHistory(const int symbol) const { return { valid.data() + symbol, std::size_t(stride), time_axis.size() }; }
+
+        // symbol-major copy of one price matrix, [symbol x time], for code that walks whole histories
+        std::vector<double> getTransposedPrices(const int price_type) const;
+};
+
+} // namespace
+
+#endif // HISTORICAL_UNIVERSE_H
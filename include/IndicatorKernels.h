@@ -0,0 +1,65 @@
+/**
+ * @file    IndicatorKernels.h
+ * @brief   Declares batch indicator kernels over whole price columns.
+ *
+ * This file contains kernels that compute an indicator for every row of a column at
+ * once, for research and for warming up the streaming indicators of Indicators.h before
+ * a backtest. Each kernel reads a column (getPriceColumn, no copy needed) and writes
+ * into a buffer the caller provides, at least as long as the input (std::invalid_argument
+ * otherwise), nothing is allocated.
+ *
+ * Every kernel has AVX2 and AVX-512 versions picked at run time from what the CPU
+ * supports, and a portable scalar version which is also the reference the SIMD versions
+ * are checked against by bench/IndicatorKernels_bench.cpp. The SIMD versions reorder
+ * the additions of the scalar ones, so results agree to rounding, not bit for bit.
+ *
+ * Inputs must be finite, a missing price (-1) is treated as a price. The rolling kernels
+ * restart their running sums from a direct sum every ANCHOR_INTERVAL rows (or every
+ * window rows if longer), so rounding does not accumulate over long histories.
+ *
+ * @author  Benny Zaionz
+ * @date    2026-10-18
+ * @version 1.0
+ */
+
+#ifndef INDICATOR_KERNELS_H
+#define INDICATOR_KERNELS_H
+
+#include <span>
+
+namespace AlgoTrading
+{
+
+enum SimdLevel{ SIMD_SCALAR, SIMD_AVX2, SIMD_AVX512 };
+
+const int ANCHOR_INTERVAL = 1024;
+
+/*---------- DISPATCH ----------*/
+
+int detectSimdLevel(); // best level the CPU supports, SIMD_SCALAR off x86
+int getSimdLevel(); // level the kernels use, detectSimdLevel() unless set
+void setSimdLevel(const int level); // clamped to detectSimdLevel(), for benchmarks and tests, not thread safe
+
+/*---------- KERNELS ----------*/
+
+// sum of the last window prices, NaN for the first window - 1 rows
+void rollingSum(std::span<const double> prices, const int window, std::span<double> out);
+
+// population standard deviation of the last window prices, NaN for the first window - 1 rows. Computed from
+// sums of deviations from a price near the window, the absolute error is about 1e-8 times the price move
+// since the last anchor, so a window whose true deviation is 0 may read slightly above it
+void rollingStdDev(std::span<const double> prices, const int window, std::span<double> out);
+
+// alpha = 2 / (period + 1), seeded with the first price like ExponentialMovingAverage
+void exponentialMovingAverage(std::span<const double> prices, const int period, std::span<double> out);
+
+// log(prices[i] / prices[i - 1]), NaN for row 0 and where either price is not positive
+void logReturns(std::span<const double> prices, std::span<double> out);
+
+// outputs[s][t] = (columns[s][t] - mean) / stddev, mean and population stddev over every
+// column at row t, 0 where they all agree. Every column and output must have the same length
+void crossSectionalZScores(std::span<const std::span<const double>> columns, std::span<const std::span<double>> outputs);
+
+} // namespace
+
+#endif // INDICATOR_KERNELS_H
@@ -0,0 +1,502 @@
+/**
+ * @file    Indicators.h
+ * @brief   Defines streaming technical indicators updated in O(1) per tick or bar.
+ *
+ * This file contains incremental indicators meant to be kept per symbol and fed from
+ * LiveEquity ticks or bars (EquitySnapshot, SnapshotRef) as they arrive, instead of being
+ * recomputed over getHistoricalPrices copies. No indicator allocates: the windowed ones take
+ * the window length as a template parameter and keep it inline as a ring buffer, so a table
+ * of thousands of symbols times dozens of indicators is one flat array.
+ *
+ * State per indicator:
+ *   ExponentialMovingAverage, RelativeStrengthIndex, VolumeWeightedAveragePrice
+ *     a few doubles, at most one cache line (checked below)
+ *   SimpleMovingAverage<N>, RollingVariance<N>, BollingerBands<N>
+ *     the window (8 * N bytes) plus less than one cache line, amortized O(1): the running
+ *     sums are recomputed from the window once every N prices to drop rounding error
+ *   RollingMin<N>, RollingMax<N>
+ *     a monotonic deque of at most N (value, sequence) pairs, amortized O(1)
+ *
+ * Every update returns the new value. A missing price (-1, as EquitySnapshot stores it)
+ * leaves the indicator unchanged. isReady() is false until the window (or period) is full,
+ * getValue() is then still the value over what has been seen.
+ *
+ * @author  Benny Zaionz
+ * @date    2026-10-18
+ * @version 1.0
+ */
+
+#ifndef INDICATORS_H
+#define INDICATORS_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+
+#include "HistoricalEquityData.h"
+#include "LiveEquity.h"
+
+namespace AlgoTrading
+{
+
+/*---------- TICK AND BAR ADAPTERS ----------*/
+
+template<typename Derived>
+class StreamingIndicator
+{
+    /*
+    feeds Derived from market data, Derived implements update(price) and, if it needs more
+    than the last price, updateBar(datetime, price, volume) which hides the one below
+    */
+
+    public:
+
+        double update(const LiveEquity& eq) { return self().updateBar(eq.getDatetime(), eq.getLast(), eq.getVolume()); }
+        double update(const EquitySnapshot& bar) { return self().updateBar(bar.getDatetime(), bar.getLast(), bar.getVolume()); }
+        double update(const SnapshotRef& bar) { return self().updateBar(bar.getDatetime(), bar.getLast(), bar.getVolume()); }
+
+        double updateBar(const DateTime&, const double price, const double) { return self().update(price); }
+
+    private:
+
+        Derived& self() { return static_cast<Derived&>(*this); }
+};
+
+/*---------- WINDOW ----------*/
+
+template<int N>
+class PriceWindow
+{
+    /*
+    the last N prices, push returns the one that fell out of the window (0 while filling).
+    wrapped() is true right after every Nth push, when the indicators recompute their running
+    sums from the window so the rounding of adding and removing prices does not accumulate
+    */
+
+    static_assert(N > 0, "PriceWindow needs a positive length");
+
+    private:
+
+        double values[N];
+        int head; // oldest value once full, next slot to write while filling
+        int count;
+
+    public:
+
+        PriceWindow(): values{}, head(0), count(0) {}
+
+        double push(const double value)
+        {
+            const double leaving = count == N ? values[head] : 0;
+
+            values[head] = value;
+            head = head + 1 == N ? 0 : head + 1;
+            count += count < N;
+
+            return leaving;
+        }
+
+        double sum() const;
+        double squaredDeviations(const double mean) const; // sum of (value - mean)^2
+
+        int size() const { return count; }
+        bool isFull() const { return count == N; }
+        bool wrapped() const { return count == N && head == 0; }
+        void reset() { head = 0; count = 0; }
+};
+
+template<int N>
+double PriceWindow<N>::sum() const
+{
+    double total = 0;
+
+    for( int i = 0; i < count; ++i )
+        total += values[i];
+
+    return total;
+}
+
+template<int N>
+double PriceWindow<N>::squaredDeviations(const double mean) const
+{
+    double total = 0;
+
+    for( int i = 0; i < count; ++i )
+        total += (values[i] - mean) * (values[i] - mean);
+
+    return total;
+}
+
+/*---------- MOVING AVERAGES ----------*/
+
+template<int N>
+class SimpleMovingAverage: public StreamingIndicator<SimpleMovingAverage<N>>
+{
+    /*
+    running sum of the window, recomputed from it once every N prices (amortized O(1)) so a
+    large price that has left the window does not leave its rounding error behind
+    */
+
+    private:
+
+        PriceWindow<N> window;
+        double sum;
+
+    public:
+
+        using StreamingIndicator<SimpleMovingAverage<N>>::update;
+
+        SimpleMovingAverage(): window{}, sum(0) {}
+
+        double update(const double price)
+        {
+            if( price < 0 )
+                return getValue();
+
+            sum += price - window.push(price);
+
+            if( window.wrapped() )
+                sum = window.sum();
+
+            return getValue();
+        }
+
+        double getValue() const { return window.size() > 0 ? sum / window.size() : 0; }
+        bool isReady() const { return window.isFull(); }
+        void reset() { window.reset(); sum = 0; }
+};
+
+class ExponentialMovingAverage: public StreamingIndicator<ExponentialMovingAverage>
+{
+    /*
+    alpha = 2 / (period + 1), seeded with the first price
+    */
+
+    private:
+
+        double alpha;
+        double value;
+        int count;
+        int period;
+
+    public:
+
+        using StreamingIndicator<ExponentialMovingAverage>::update;
+
+        explicit ExponentialMovingAverage(const int period_): alpha(2.0 / (period_ + 1)), value(0), count(0), period(period_) {}
+
+        double update(const double price)
+        {
+            if( price < 0 )
+                return value;
+
+            value = count == 0 ? price : value + alpha * (price - value);
+            count += count < period;
+
+            return value;
+        }
+
+        double getValue() const { return value; }
+        bool isReady() const { return count == period; }
+        void reset() { value = 0; count = 0; }
+};
+
+/*---------- ROLLING MIN AND MAX ----------*/
+
+template<int N, typename Compare>
+class RollingExtreme: public StreamingIndicator<RollingExtreme<N, Compare>>
+{
+    /*
+    monotonic deque over the last N prices: from the front, every kept price beats every later
+    one under Compare, so the front is the extreme. A new price drops the ones at the back it
+    beats (they can never be the extreme again), each price is pushed and dropped at most once
+    */
+
+    static_assert(N > 0, "RollingExtreme needs a positive length");
+
+    private:
+
+        double values[N];
+        std::int64_t sequences[N]; // when each kept price arrived
+        int front;
+        int count; // kept prices
+        std::int64_t sequence; // prices seen
+
+    public:
+
+        using StreamingIndicator<RollingExtreme<N, Compare>>::update;
+
+        RollingExtreme(): values{}, sequences{}, front(0), count(0), sequence(0) {}
+
+        double update(const double price)
+        {
+            if( price < 0 )
+                return getValue();
+
+            // expire the front once it is N prices old
+            if( count > 0 && sequences[front] <= sequence - N )
+            {
+                front = front + 1 == N ? 0 : front + 1;
+                count--;
+            }
+
+            while( count > 0 && !Compare()(values[back()], price) )
+                count--;
+
+            const int slot = count == 0 ? front : (back() + 1 == N ? 0 : back() + 1);
+            values[slot] = price;
+            sequences[slot] = sequence++;
+            count++;
+
+            return getValue();
+        }
+
+        double getValue() const { return count > 0 ? values[front] : 0; }
+        bool isReady() const { return sequence >= N; }
+        void reset() { front = 0; count = 0; sequence = 0; }
+
+    private:
+
+        int back() const { return front + count - 1 < N ? front + count - 1 : front + count - 1 - N; }
+};
+
+// strict comparisons keep only the newest of equal prices, so the deque holds fewer entries
+template<int N>
+using RollingMin = RollingExtreme<N, std::less<double>>;
+
+template<int N>
+using RollingMax = RollingExtreme<N, std::greater<double>>;
+
+/*---------- VARIANCE AND BANDS ----------*/
+
+template<int N>
+class RollingVariance: public StreamingIndicator<RollingVariance<N>>
+{
+    /*
+    Welford's update over a sliding window: while filling, the usual one-sample step, once
+    full, the price leaving and the price entering are swapped in one step, which avoids the
+    cancellation of keeping a sum of squares. mean and m2 are recomputed from the window once
+    every N prices (amortized O(1)), the swap steps would otherwise carry rounding error forever
+    */
+
+    private:
+
+        PriceWindow<N> window;
+        double mean;
+        double m2; // sum of squared deviations from mean
+
+    public:
+
+        using StreamingIndicator<RollingVariance<N>>::update;
+
+        RollingVariance(): window{}, mean(0), m2(0) {}
+
+        double update(const double price)
+        {
+            if( price < 0 )
+                return getValue();
+
+            if( !window.isFull() )
+            {
+                window.push(price);
+
+                const double delta = price - mean;
+                mean += delta / window.size();
+                m2 += delta * (price - mean);
+            }
+            else
+            {
+                const double leaving = window.push(price);
+                const double old_mean = mean;
+
+                mean += (price - leaving) / N;
+                m2 += (price - leaving) * (price - mean + leaving - old_mean);
+                m2 = std::max(m2, 0.0);
+            }
+
+            if( window.wrapped() )
+            {
+                mean = window.sum() / N;
+                m2 = window.squaredDeviations(mean);
+            }
+
+            return getValue();
+        }
+
+        double getValue() const { return window.size() > 0 ? m2 / window.size() : 0; } // population variance
+        double getSampleVariance() const { return window.size() > 1 ? m2 / (window.size() - 1) : 0; }
+        double getStdDev() const { return std::sqrt(getValue()); }
+        double getMean() const { return mean; }
+        bool isReady() const { return window.isFull(); }
+        void reset() { window.reset(); mean = 0; m2 = 0; }
+};
+
+template<int N>
+class BollingerBands: public StreamingIndicator<BollingerBands<N>>
+{
+    /*
+    middle is the N price mean, the bands are width population standard deviations away
+    */
+
+    private:
+
+        RollingVariance<N> variance;
+        double width;
+
+    public:
+
+        using StreamingIndicator<BollingerBands<N>>::update;
+
+        explicit BollingerBands(const double width_ = 2): variance{}, width(width_) {}
+
+        double update(const double price) { variance.update(price); return getValue(); }
+
+        double getValue() const { return getMiddle(); }
+        double getMiddle() const { return variance.getMean(); }
+        double getUpper() const { return variance.getMean() + width * variance.getStdDev(); }
+        double getLower() const { return variance.getMean() - width * variance.getStdDev(); }
+        double getPercentB(const double price) const; // where price sits between the bands, 0 at lower, 1 at upper
+        bool isReady() const { return variance.isReady(); }
+        void reset() { variance.reset(); }
+};
+
+template<int N>
+double BollingerBands<N>::getPercentB(const double price) const
+{
+    const double spread = getUpper() - getLower();
+    return spread > 0 ? (price - getLower()) / spread : 0.5;
+}
+
+/*---------- MOMENTUM ----------*/
+
+class RelativeStrengthIndex: public StreamingIndicator<RelativeStrengthIndex>
+{
+    /*
+    Wilder's RSI: the first period price changes are averaged plainly, later ones smoothed
+    with weight 1 / period, 100 - 100 / (1 + average gain / average loss)
+    */
+
+    private:
+
+        double previous;
+        double average_gain;
+        double average_loss;
+        int count; // price changes seen, up to period
+        int period;
+        bool started;
+
+    public:
+
+        using StreamingIndicator<RelativeStrengthIndex>::update;
+
+        explicit RelativeStrengthIndex(const int period_ = 14):
+            previous(0), average_gain(0), average_loss(0), count(0), period(period_), started(false) {}
+
+        double update(const double price)
+        {
+            if( price < 0 )
+                return getValue();
+
+            if( !started )
+            {
+                previous = price;
+                started = true;
+                return getValue();
+            }
+
+            const double change = price - previous;
+            const double gain = change > 0 ? change : 0;
+            const double loss = change < 0 ? -change : 0;
+
+            previous = price;
+
+            if( count < period )
+            {
+                count++;
+                average_gain += (gain - average_gain) / count;
+                average_loss += (loss - average_loss) / count;
+            }
+            else
+            {
+                average_gain += (gain - average_gain) / period;
+                average_loss += (loss - average_loss) / period;
+            }
+
+            return getValue();
+        }
+
+        double getValue() const
+        {
+            if( average_loss == 0 )
+                return average_gain == 0 ? 50 : 100;
+
+            return 100 - 100 / (1 + average_gain / average_loss);
+        }
+
+        bool isReady() const { return count == period; }
+        void reset() { average_gain = average_loss = 0; count = 0; started = false; }
+};
+
+/*---------- VOLUME ----------*/
+
+class VolumeWeightedAveragePrice: public StreamingIndicator<VolumeWeightedAveragePrice>
+{
+    /*
+    sum(price * volume) / sum(volume) since the start of the session, volume is what traded
+    in the tick or bar (not a running day total). Fed from ticks or bars the session restarts
+    on the first one of a new date, fed prices directly it runs until reset()
+    */
+
+    private:
+
+        double price_volume;
+        double volume;
+        std::int64_t session_day; // days since epoch of the session
+
+    public:
+
+        using StreamingIndicator<VolumeWeightedAveragePrice>::update;
+
+        VolumeWeightedAveragePrice(): price_volume(0), volume(0), session_day(std::numeric_limits<std::int64_t>::min()) {}
+
+        double update(const double price, const double volume_)
+        {
+            if( price < 0 || volume_ <= 0 )
+                return getValue();
+
+            price_volume += price * volume_;
+            volume += volume_;
+
+            return getValue();
+        }
+
+        double updateBar(const DateTime& datetime_, const double price, const double volume_)
+        {
+            if( datetime_.getEpochDay() != session_day )
+            {
+                reset();
+                session_day = datetime_.getEpochDay();
+            }
+
+            return update(price, volume_);
+        }
+
+        double getValue() const { return volume > 0 ? price_volume / volume : 0; }
+        double getVolume() const { return volume; }
+        bool isReady() const { return volume > 0; }
+        void reset() { price_volume = 0; volume = 0; }
+};
+
+/*---------- SIZES ----------*/
+
+static_assert(sizeof(ExponentialMovingAverage) <= 64, "ExponentialMovingAverage should fit in a cache line");
+static_assert(sizeof(RelativeStrengthIndex) <= 64, "RelativeStrengthIndex should fit in a cache line");
+static_assert(sizeof(VolumeWeightedAveragePrice) <= 64, "VolumeWeightedAveragePrice should fit in a cache line");
+static_assert(sizeof(SimpleMovingAverage<20>) <= 8 * 20 + 64, "SimpleMovingAverage should be its window plus a cache line");
+static_assert(sizeof(BollingerBands<20>) <= 8 * 20 + 64, "BollingerBands should be its window plus a cache line");
+
+} // namespace
+
+#endif // INDICATORS_H
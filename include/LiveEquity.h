@@ -7,6 +7,7 @@
 #include <string>
 #include <iostream>
 #include "EquitySnapshot.h"
+#include "SymbolTable.h"
 
 namespace AlgoTrading
 {
@@ -15,18 +16,20 @@ class LiveEquity
 {
     private:
 
-        const std::string ticker;
+        SymbolId symbol;
         EquitySnapshot currentSnapshot;
 
     public:
 
         /*---------- CONSTRUCTOR ----------*/
 
-        LiveEquity(const std::string& ticker_ = "", const EquitySnapshot& snap = EquitySnapshot());
+        LiveEquity(const std::string& ticker_ = "", const EquitySnapshot& snap = EquitySnapshot()); // interns ticker_
+        explicit LiveEquity(const SymbolId symbol_, const EquitySnapshot& snap = EquitySnapshot());
 
         /*---------- GETTERS ----------*/
 
-        std::string getTicker() const { return ticker; }
+        SymbolId getSymbol() const { return symbol; }
+        const std::string& getTicker() const { return symbolTicker(symbol); }
         DateTime getDatetime() const { return currentSnapshot.getDatetime(); }
 
         double getLast() const { return currentSnapshot.getLast(); }
@@ -35,6 +38,9 @@ class LiveEquity
         double getBid() const { return currentSnapshot.getBid(); }
         double getAsk() const { return currentSnapshot.getAsk(); }
         double getVolume() const { return currentSnapshot.getVolume(); }
+        Price getLastPrice() const { return currentSnapshot.getLastPrice(); }
+        Price getBidPrice() const { return currentSnapshot.getBidPrice(); }
+        Price getAskPrice() const { return currentSnapshot.getAskPrice(); }
         EquitySnapshot getCurrentSnapshot() const { return currentSnapshot; }
 
         /*---------- SETTERS ----------*/
@@ -46,6 +52,9 @@ class LiveEquity
         void setHigh(const double high_) { currentSnapshot.setHigh(high_); }
         void setBid(const double bid_) { currentSnapshot.setBid(bid_); }
         void setAsk(const double ask_) { currentSnapshot.setAsk(ask_); }
+        void setLast(const Price last_) { currentSnapshot.setLast(last_); }
+        void setBid(const Price bid_) { currentSnapshot.setBid(bid_); }
+        void setAsk(const Price ask_) { currentSnapshot.setAsk(ask_); }
 
         /*---------- PRINT HELPER ----------*/
 
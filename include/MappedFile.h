@@ -0,0 +1,53 @@
+/**
+ * @file    MappedFile.h
+ * @brief   Defines the MappedFile class, a read-only memory mapping of a whole file.
+ *
+ * This file contains the declaration of the MappedFile class. The mapping is shared
+ * and read-only, so every process that maps the same file reads the same pages from
+ * the OS cache. It is used to open HistoricalEquityData bar files without copying.
+ *
+ * @author  Benny Zaionz
+ * @date    2026-10-18
+ * @version 1.0
+ */
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+namespace AlgoTrading
+{
+
+class MappedFile
+{
+    private:
+
+        const char* mapped;
+        std::size_t length;
+
+        #ifdef _WIN32
+        void* file_handle;
+        void* mapping_handle;
+        #endif
+
+    public:
+
+        /*---------- CONSTRUCTOR ----------*/
+
+        MappedFile(const std::string& path); // throws std::runtime_error if the file cannot be mapped
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /*---------- GETTERS ----------*/
+
+        const char* data() const { return mapped; }
+        std::size_t size() const { return length; }
+};
+
+} // namespace
+
+#endif // MAPPED_FILE_H
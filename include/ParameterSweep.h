@@ -0,0 +1,59 @@
+/**
+ * @file    ParameterSweep.h
+ * @brief   Defines runSweep, one strategy backtested over many parameter sets in parallel.
+ *
+ * This file contains the runSweep function template. The HistoricalEquityData sources
+ * are loaded once by the caller (HistoricalEquityData::load maps bar files without
+ * copying) and only ever read, so every run on every worker shares them. Runs are
+ * scheduled on a ThreadPool, which steals work between workers so a few long runs do
+ * not leave the other cores idle. Each worker keeps one Backtest and reuses its
+ * Portfolio and buffers for every run it is given, a run allocates nothing new once the
+ * worker has warmed up. Only the compact BacktestResult of each run is kept.
+ *
+ * @author  Benny Zaionz
+ * @date    2026-10-18
+ * @version 1.0
+ */
+
+#ifndef PARAMETER_SWEEP_H
+#define PARAMETER_SWEEP_H
+
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "Backtest_lib.h"
+#include "ThreadPool.h"
+
+namespace AlgoTrading
+{
+
+/*
+make_strategy(params[i]) returns the strategy for run i by value (any type derived from Strategy),
+results[i] is that run's summary. Turn off config.record_equity and config.record_fills unless the
+runs need them, the summary does not. Exceptions from a run stop the sweep and are rethrown
+*/
+template<typename Params, typename MakeStrategy>
+std::vector<BacktestResult> runSweep(ThreadPool& pool,
+                                     const std::vector<const HistoricalEquityData*>& sources,
+                                     const BacktestConfig& config,
+                                     std::span<const Params> params,
+                                     MakeStrategy make_strategy)
+{
+    std::vector<BacktestResult> results(params.size());
+    std::vector<std::unique_ptr<Backtest>> backtests(pool.getNumThreads()); // one per worker, created on its first run
+
+    pool.parallelFor(static_cast<int>(params.size()), [&](const int index, const int worker) {
+        if( backtests[worker] == nullptr )
+            backtests[worker] = std::make_unique<Backtest>(sources, config);
+
+        auto strategy = make_strategy(params[index]);
+        results[index] = backtests[worker]->run(strategy);
+    });
+
+    return results;
+}
+
+} // namespace
+
+#endif // PARAMETER_SWEEP_H
@@ -1,46 +1,130 @@
 #ifndef PORTFOLIO_H
 #define PORTFOLIO_H
 
+#include <span>
+#include <string_view>
 #include <vector>
+#include "FeeModels.h"
 #include "LiveEquity.h"
+#include "PortfolioState.h"
 
 namespace AlgoTrading
 {
 
+class TradeJournal;
+
 const int DOES_NOT_CONTAIN = -1; // for containsTicker()
 
-enum TradeStatus{ SUCCESSFUL_TRADE, INSUFFICIENT_FUNDS, INSUFFICIENT_SHARES, TICKER_NOT_IN_PORTFOLIO };
+enum TradeStatus{ SUCCESSFUL_TRADE, INSUFFICIENT_FUNDS, INSUFFICIENT_SHARES, TICKER_NOT_IN_PORTFOLIO, BATCH_REJECTED, RISK_REJECTED, INVALID_ORDER }; // RISK_REJECTED by RiskEngine
+
+struct Order
+{
+    SymbolId symbol;
+    int side; // enum OrderSide
+    int quantity;
+    Price price;
+};
+
+const int MARK_CHECK_INTERVAL = 4096; // debug builds recompute the running marks from scratch every this many updates
 
-const double COMMISSION_PER_SHARE = 0.005; // from IBKR pro trading license: https://www.interactivebrokers.com/en/pricing/commissions-stocks.php
-const int MIN_COMMISSION = 1; // also from IBKR pro trading license, any commission price less than 1 will round up to 1
+struct Position
+{
+    LiveEquity equity;
+    int shares;
+    Money cost_basis; // what the shares held cost, average cost, commissions excluded
+
+    Position(const LiveEquity& equity_, const int shares_, const Money cost_basis_ = Money()):
+        equity(equity_), shares(shares_), cost_basis(cost_basis_) {}
 
-class Portfolio
+    // both are zero while the equity has no last price
+    Money getMarketValue() const { return equity.getLastPrice().isMissing() ? Money() : equity.getLastPrice() * shares; }
+    Money getUnrealizedPnl() const { return equity.getLastPrice().isMissing() ? Money() : getMarketValue() - cost_basis; }
+};
+
+/*
+the fee model is a template parameter so its commission() is inlined into every fill, any FeeModel
+works (the member functions are in Portfolio.tpp), the bundled ones are compiled once in Portfolio.cpp,
+Portfolio is the original IBKR fixed pricing
+*/
+template<FeeModel FeePolicy>
+class BasicPortfolio
 {
     private:
         
-        double cash;
-        std::vector<LiveEquity> equities;
-        std::vector<int> num_shares;
+        Money cash;
+        FeePolicy fees;
+        std::vector<Position> positions; // dense, in the order the tickers were first bought
+
+        // open addressing hash index (linear probing) from SymbolId to position, slots hold
+        // indices into positions or DOES_NOT_CONTAIN, the size is always a power of two
+        std::vector<int> slots;
+
+        // running sums of Position::getMarketValue() and getUnrealizedPnl(), every change to a
+        // position takes its old marks out and puts its new ones in, so reads are O(1)
+        Money market_value;
+        Money unrealized_pnl;
+        int updates_since_check;
+
+        void unmark(const Position& position) { market_value -= position.getMarketValue(); unrealized_pnl -= position.getUnrealizedPnl(); }
+        void mark(const Position& position) { market_value += position.getMarketValue(); unrealized_pnl += position.getUnrealizedPnl(); }
+        void checkMarks(); // asserts the running marks match a full recomputation, only in debug builds
+
+        // lock-free copies for other threads, written only once someone asked for them
+        PortfolioStatePublisher publisher;
+
+        PositionState getPositionState(const int index) const;
+        void changed(const int index); // called after every mutation of positions[index] (and the cash that went with it), DOES_NOT_CONTAIN for cash only
+
+        TradeJournal* journal; // not owned, nullptr when not journaling
+
+        // throws std::invalid_argument if a journal is attached and cannot record symbol_, called before any change
+        void checkJournalable(const SymbolId symbol_) const;
+
+        // record the outcome in the journal (if any) and return the TradeStatus
+        int filled(const SymbolId symbol_, const int side, const int quantity, const Price price, const Money commission);
+        int reject(const SymbolId symbol_, const int side, const int quantity, const Price price, const int status);
+        int reject(std::string_view ticker_, const int side, const int quantity, const Price price, const int status);
+
+        std::size_t findSlot(const SymbolId symbol_) const; // slot holding symbol_, or the empty slot it would go in
+        void growIndex();
+
+        Money getCommission(const int side, const int quantity, const Price price) const { return fees.commission(side, quantity, price); }
+        int addEquity(const SymbolId symbol_, const int quantity, const Money cost); // both return the position index
+        int addEquity(const LiveEquity& eq, const int quantity, const Money cost);
+        void removeEquity(const int index, const int quantity); // takes out the sold shares' share of the cost basis
 
-        double getCommission(int quantity) const;
-        void addEquity(const std::string& ticker_, const int quantity);
-        void addEquity(const LiveEquity& eq, const int quantity);
-        void removeEquity(const std::string& ticker_, int quantity);
+        std::vector<Money> batch_commissions; // executeBatch scratch, keeps its capacity between batches
 
     public:
         
         /*---------- CONSTRUCTOR ----------*/
 
-        Portfolio(const double cash_); // only construct Portfolio with empty equities and num_shares to ensure that amounts line up
+        BasicPortfolio(const double cash_, const FeePolicy& fees_ = FeePolicy()); // cash_ is rounded to the nearest tick, only construct Portfolio with no positions to ensure that amounts line up
+
+        // back to a new BasicPortfolio(cash_) with the same fees, keeps the capacity of the positions and their index
+        // so a reused Portfolio does not allocate again, detaches any journal and state buffer as assigning a new one would
+        void reset(const double cash_);
 
         /*---------- GETTERS ----------*/
 
         std::vector<std::string> getHoldings() const; // define in cpp
-        std::vector<LiveEquity> getEquities() const { return equities; }
-        std::vector<int> getNumShares() const { return num_shares; }
-        double getCash() const { return cash; }
-        double getValue() const; // define in cpp
-        int getNumEquities() const { return equities.size(); }
+        std::vector<LiveEquity> getEquities() const; // copies, prefer getPositions()
+        std::vector<int> getNumShares() const;
+        const std::vector<Position>& getPositions() const { return positions; }
+        double getCash() const { return cash.toDouble(); }
+        double getValue() const { return getValueMoney().toDouble(); }
+        Money getCashMoney() const { return cash; }
+        Money getValueMoney() const { return cash + market_value; } // cash plus every holding at its last price, holdings without a last price are skipped
+        Money getMarketValue() const { return market_value; }
+        Money getUnrealizedPnl() const { return unrealized_pnl; }
+        Money getUnrealizedPnl(const SymbolId symbol_) const; // zero if not held
+        Money recomputeMarketValue() const; // O(holdings) sum from scratch, for reconciling against getMarketValue()
+        int getNumEquities() const { return positions.size(); }
+        const FeePolicy& getFees() const { return fees; }
+
+        /*---------- SETTERS ----------*/
+
+        void setFees(const FeePolicy& fees_) { fees = fees_; } // e.g. a new month's volume for IbkrTieredFees
 
         /*---------- PRINT HELPER ---------*/
 
@@ -48,7 +132,44 @@ class Portfolio
 
         /*---------- ADDING AND REMOVING EQUITIES ----------*/
 
-        int containsTicker(const std::string ticker_ = "") const; // returns the index of the ticker if it exists, otherwise returns -1
+        int containsTicker(const std::string& ticker_ = "") const; // returns the index of the ticker if it exists, otherwise returns -1, O(1)
+        int containsSymbol(const SymbolId symbol_) const;
+
+        /*---------- CONCURRENT READERS ----------*/
+
+        /*
+        the buffer every later mutation is published to, starts publishing on the first call,
+        readers on any thread call read() on it without locking and without slowing the writer,
+        keep the shared_ptr rather than the Portfolio, it stays valid if the Portfolio is destroyed
+        */
+        std::shared_ptr<const PortfolioStateBuffer> getStateBuffer();
+
+        /*---------- JOURNALING ----------*/
+
+        /*
+        every later fill, rejection and cash adjustment is recorded to journal_ (nullptr to stop). A new
+        (empty) journal gets the current cash as its first adjustment, so attach it right after construction.
+        A journal that already has records is resumed: replay it into a zero cash Portfolio, before or after
+        attaching, see TradeJournal::replay. With a journal attached, trading a ticker longer than
+        JOURNAL_MAX_TICKER throws std::invalid_argument before anything changes
+        */
+        void setJournal(TradeJournal* journal_);
+
+        /*---------- CASH AND EXTERNAL FILLS ----------*/
+
+        void adjustCash(const Money amount); // deposits, withdrawals, dividends, fees charged outside a fill
+        void applyFill(const SymbolId symbol_, const int side, const int quantity, const Price price, const Money commission); // a fill that already happened (broker execution), no checks
+
+        // the same two without journaling, for TradeJournal::replay
+        void replayCashAdjustment(const Money amount);
+        void replayFill(const SymbolId symbol_, const int side, const int quantity, const Price price, const Money commission);
+
+        /*---------- MARKET DATA ----------*/
+
+        // O(1) re-mark of one holding, return the position index or DOES_NOT_CONTAIN if it is not held
+        int updateLast(const SymbolId symbol_, const Price last_);
+        int updateLast(const std::string& ticker_, const double last_);
+        int updateMarketData(const LiveEquity& eq); // replaces the held snapshot with eq's
 
         /*---------- BUYING AND SELLING ----------*/
 
@@ -56,8 +177,47 @@ class Portfolio
         int buyEquity(const LiveEquity& eq, const int num_shares_buy, const double price, const bool verbose = false);
         int sellEquity(const std::string& ticker_, const int num_shares_sell, const double price, const bool verbose = false);
 
+        // same as above with the price already in ticks, the double versions round price and forward here
+        int buyEquity(const std::string& ticker_, const int num_shares_buy, const Price price, const bool verbose = false);
+        int buyEquity(const LiveEquity& eq, const int num_shares_buy, const Price price, const bool verbose = false);
+        int sellEquity(const std::string& ticker_, const int num_shares_sell, const Price price, const bool verbose = false);
+
+        // keyed on the interned id, the string versions look the id up once and forward here
+        int buyEquity(const SymbolId symbol_, const int num_shares_buy, const double price, const bool verbose = false);
+        int sellEquity(const SymbolId symbol_, const int num_shares_sell, const double price, const bool verbose = false);
+        int buyEquity(const SymbolId symbol_, const int num_shares_buy, const Price price, const bool verbose = false);
+        int sellEquity(const SymbolId symbol_, const int num_shares_sell, const Price price, const bool verbose = false);
+
+        /*---------- BATCH EXECUTION ----------*/
+
+        /*
+        applies orders and writes a TradeStatus per order into results (at least orders.size() long, throws
+        std::invalid_argument otherwise), returns the number of orders filled. Every sale is applied before
+        any buy (each in the order given) with the same checks as buyEquity / sellEquity, so the sales of a
+        rebalance fund its buys wherever they are listed. With all_or_nothing the whole batch is validated
+        first: every sale against the shares held, then the cash once every order is netted, which must stay
+        above zero as in buyEquity. If either fails every result is BATCH_REJECTED and nothing changes.
+        An order that is neither BUY nor SELL is INVALID_ORDER, with all_or_nothing the rest are BATCH_REJECTED
+        */
+        int executeBatch(std::span<const Order> orders, std::span<int> results, const bool all_or_nothing = false);
+
 };
 
+using Portfolio = BasicPortfolio<IbkrFixedFees>;
+
+} // end namespace
+
+#include "Portfolio.tpp"
+
+namespace AlgoTrading
+{
+
+// compiled in Portfolio.cpp
+extern template class BasicPortfolio<IbkrFixedFees>;
+extern template class BasicPortfolio<ZeroFees>;
+extern template class BasicPortfolio<IbkrTieredFees>;
+extern template class BasicPortfolio<IbkrTieredAllInFees>;
+
 } // end namespace
 
 #endif
\ No newline at end of file
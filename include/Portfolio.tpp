@@ -0,0 +1,852 @@
+/**
+ * @file    Portfolio.tpp
+ * @brief   Defines the BasicPortfolio member functions.
+ *
+ * This file contains the definitions of every BasicPortfolio member, included at the end
+ * of Portfolio.h so that a BasicPortfolio can be instantiated with any FeeModel. The
+ * models Portfolio.cpp instantiates explicitly are declared extern in Portfolio.h, so
+ * translation units using them do not compile these definitions again.
+ *
+ * @author  Benny Zaionz
+ * @date    2026-10-18
+ * @version 1.0
+ */
+
+#ifndef PORTFOLIO_TPP
+#define PORTFOLIO_TPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "Portfolio.h"
+#include "TradeJournal.h"
+
+namespace AlgoTrading
+{
+
+const std::size_t PORTFOLIO_INITIAL_SLOTS = 16;
+
+// Fibonacci hashing, ids are dense small integers so the high bits of the product are the well mixed ones
+inline std::size_t hashPortfolioSymbol(const SymbolId symbol_) { return static_cast<std::size_t>((std::uint64_t(symbol_) * 0x9E3779B97F4A7C15ULL) >> 32); }
+
+template<FeeModel FeePolicy>
+BasicPortfolio<FeePolicy>::BasicPortfolio(const double cash_, const FeePolicy& fees_):
+    cash(Money::fromDouble(cash_)), 
+    fees(fees_),
+    positions{}, 
+    slots(PORTFOLIO_INITIAL_SLOTS, DOES_NOT_CONTAIN),
+    market_value(),
+    unrealized_pnl(),
+    updates_since_check(0),
+    publisher{},
+    journal(nullptr),
+    batch_commissions{} {}
+
+template<FeeModel FeePolicy>
+void BasicPortfolio<FeePolicy>::reset(const double cash_)
+{
+    cash = Money::fromDouble(cash_);
+    positions.clear();
+    std::fill(slots.begin(), slots.end(), DOES_NOT_CONTAIN);
+    market_value = Money();
+    unrealized_pnl = Money();
+    updates_since_check = 0;
+    publisher = PortfolioStatePublisher{};
+    journal = nullptr;
+}
+
+
+template<FeeModel FeePolicy>
+std::vector<std::string> BasicPortfolio<FeePolicy>::getHoldings() const
+{
+    std::vector<std::string> holdings = {};
+    holdings.reserve(positions.size());
+
+    for( int i = 0; i < positions.size(); i++)
+        holdings.push_back(positions[i].equity.getTicker());
+
+    return holdings;
+}
+
+template<FeeModel FeePolicy>
+std::vector<LiveEquity> BasicPortfolio<FeePolicy>::getEquities() const
+{
+    std::vector<LiveEquity> equities = {};
+    equities.reserve(positions.size());
+
+    for( int i = 0; i < positions.size(); i++)
+        equities.push_back(positions[i].equity);
+
+    return equities;
+}
+
+template<FeeModel FeePolicy>
+std::vector<int> BasicPortfolio<FeePolicy>::getNumShares() const
+{
+    std::vector<int> num_shares = {};
+    num_shares.reserve(positions.size());
+
+    for( int i = 0; i < positions.size(); i++)
+        num_shares.push_back(positions[i].shares);
+
+    return num_shares;
+}
+
+template<FeeModel FeePolicy>
+Money BasicPortfolio<FeePolicy>::getUnrealizedPnl(const SymbolId symbol_) const
+{
+    int index = containsSymbol(symbol_);
+
+    if( index == DOES_NOT_CONTAIN )
+        return Money();
+
+    return positions[index].getUnrealizedPnl();
+}
+
+template<FeeModel FeePolicy>
+Money BasicPortfolio<FeePolicy>::recomputeMarketValue() const
+{
+    Money value = Money();
+
+    for( const Position& position : positions )
+        value += position.getMarketValue();
+    
+    return value;
+}
+
+template<FeeModel FeePolicy>
+void BasicPortfolio<FeePolicy>::print(int print_type) const
+{
+    
+    std::cout << std::endl << "---------- Portfolio ----------" << std::endl;
+    
+    std::cout << "Cash: $" << getCash() << std::endl;
+    
+    for( const Position& position : positions )
+    {
+        position.equity.print(print_type);
+        std::cout << ", Shares: " << position.shares << std::endl;
+    }
+
+    std::cout << "-------------------------------" << std::endl;
+
+}
+
+/*---------- RUNNING MARKS ----------*/
+
+template<FeeModel FeePolicy>
+void BasicPortfolio<FeePolicy>::checkMarks()
+{
+    #ifndef NDEBUG
+    if( ++updates_since_check < MARK_CHECK_INTERVAL )
+        return;
+
+    updates_since_check = 0;
+
+    Money pnl = Money();
+
+    for( const Position& position : positions )
+        pnl += position.getUnrealizedPnl();
+
+    // all fixed-point, so any difference is a missed mark() / unmark() rather than rounding
+    assert( recomputeMarketValue() == market_value );
+    assert( pnl == unrealized_pnl );
+    #endif
+}
+
+/*---------- CONCURRENT READERS ----------*/
+
+template<FeeModel FeePolicy>
+PositionState BasicPortfolio<FeePolicy>::getPositionState(const int index) const
+{
+    const Position& position = positions[index];
+
+    return PositionState{ position.equity.getSymbol(), position.shares, position.cost_basis, position.equity.getLastPrice() };
+}
+
+template<FeeModel FeePolicy>
+void BasicPortfolio<FeePolicy>::changed(const int index)
+{
+    checkMarks();
+
+    PortfolioStateBuffer* buffer = publisher.get();
+
+    if( buffer == nullptr )
+        return;
+
+    // only the slot that changed and the totals, readers keep the rest from earlier writes
+    buffer->beginWrite();
+
+    if( index != DOES_NOT_CONTAIN )
+        buffer->writePosition(index, getPositionState(index));
+
+    buffer->writeTotals(cash, market_value, unrealized_pnl);
+    buffer->endWrite();
+}
+
+template<FeeModel FeePolicy>
+std::shared_ptr<const PortfolioStateBuffer> BasicPortfolio<FeePolicy>::getStateBuffer()
+{
+    if( !publisher.isActive() )
+    {
+        publisher.activate();
+
+        PortfolioStateBuffer* buffer = publisher.get();
+
+        buffer->beginWrite();
+
+        for( int i = 0; i < positions.size(); i++ )
+            buffer->writePosition(i, getPositionState(i));
+
+        buffer->writeTotals(cash, market_value, unrealized_pnl);
+        buffer->endWrite();
+    }
+
+    return publisher.share();
+}
+
+/*---------- JOURNALING ----------*/
+
+template<FeeModel FeePolicy>
+void BasicPortfolio<FeePolicy>::setJournal(TradeJournal* journal_)
+{
+    journal = journal_;
+
+    // the starting cash, replay begins from zero, a journal with records already holds it
+    if( journal != nullptr && journal->getLastSequence() == 0 )
+        journal->recordCashAdjustment(cash);
+}
+
+template<FeeModel FeePolicy>
+void BasicPortfolio<FeePolicy>::checkJournalable(const SymbolId symbol_) const
+{
+    if( journal != nullptr && symbol_ != INVALID_SYMBOL && symbolTicker(symbol_).size() > JOURNAL_MAX_TICKER )
+        throw std::invalid_argument("Ticker too long for trade journal: " + symbolTicker(symbol_));
+}
+
+template<FeeModel FeePolicy>
+int BasicPortfolio<FeePolicy>::filled(const SymbolId symbol_, const int side, const int quantity, const Price price, const Money commission)
+{
+    if( journal != nullptr )
+        journal->recordFill(symbolTicker(symbol_), side, quantity, price, commission);
+
+    return SUCCESSFUL_TRADE;
+}
+
+template<FeeModel FeePolicy>
+int BasicPortfolio<FeePolicy>::reject(const SymbolId symbol_, const int side, const int quantity, const Price price, const int status)
+{
+    if( journal != nullptr )
+        journal->recordRejection(symbol_ == INVALID_SYMBOL ? std::string_view() : std::string_view(symbolTicker(symbol_)), side, quantity, price, status);
+
+    return status;
+}
+
+template<FeeModel FeePolicy>
+int BasicPortfolio<FeePolicy>::reject(std::string_view ticker_, const int side, const int quantity, const Price price, const int status)
+{
+    if( journal != nullptr )
+        journal->recordRejection(ticker_, side, quantity, price, status);
+
+    return status;
+}
+
+/*---------- CASH AND EXTERNAL FILLS ----------*/
+
+template<FeeModel FeePolicy>
+void BasicPortfolio<FeePolicy>::adjustCash(const Money amount)
+{
+    if( journal != nullptr )
+        journal->recordCashAdjustment(amount);
+
+    replayCashAdjustment(amount);
+}
+
+template<FeeModel FeePolicy>
+void BasicPortfolio<FeePolicy>::applyFill(const SymbolId symbol_, const int side, const int quantity, const Price price, const Money commission)
+{
+    checkJournalable(symbol_);
+    replayFill(symbol_, side, quantity, price, commission);
+    filled(symbol_, side, quantity, price, commission);
+}
+
+template<FeeModel FeePolicy>
+void BasicPortfolio<FeePolicy>::replayCashAdjustment(const Money amount)
+{
+    cash += amount;
+
+    changed(DOES_NOT_CONTAIN);
+}
+
+template<FeeModel FeePolicy>
+void BasicPortfolio<FeePolicy>::replayFill(const SymbolId symbol_, const int side, const int quantity, const Price price, const Money commission)
+{
+    Money gross = price * quantity;
+
+    if( side == BUY )
+    {
+        cash -= gross + commission;
+        addEquity(symbol_, quantity, gross);
+    }
+    else
+    {
+        int index = containsSymbol(symbol_);
+
+        if( index == DOES_NOT_CONTAIN ) // short, open an empty position to sell from
+            index = addEquity(symbol_, 0, Money());
+
+        cash += gross - commission;
+        removeEquity(index, quantity);
+    }
+}
+
+/*---------- MARKET DATA ----------*/
+
+template<FeeModel FeePolicy>
+int BasicPortfolio<FeePolicy>::updateLast(const SymbolId symbol_, const Price last_)
+{
+    int index = containsSymbol(symbol_);
+
+    if( index == DOES_NOT_CONTAIN )
+        return DOES_NOT_CONTAIN;
+
+    unmark(positions[index]);
+    positions[index].equity.setLast(last_);
+    mark(positions[index]);
+
+    changed(index);
+
+    return index;
+}
+
+template<FeeModel FeePolicy>
+int BasicPortfolio<FeePolicy>::updateLast(const std::string& ticker_, const double last_)
+{
+    return updateLast(findSymbol(ticker_), Price::fromPrice(last_));
+}
+
+template<FeeModel FeePolicy>
+int BasicPortfolio<FeePolicy>::updateMarketData(const LiveEquity& eq)
+{
+    int index = containsSymbol(eq.getSymbol());
+
+    if( index == DOES_NOT_CONTAIN )
+        return DOES_NOT_CONTAIN;
+
+    unmark(positions[index]);
+    positions[index].equity = eq;
+    mark(positions[index]);
+
+    changed(index);
+
+    return index;
+}
+
+/*---------- HOLDINGS INDEX ----------*/
+
+template<FeeModel FeePolicy>
+std::size_t BasicPortfolio<FeePolicy>::findSlot(const SymbolId symbol_) const
+{
+    const std::size_t mask = slots.size() - 1;
+    std::size_t slot = hashPortfolioSymbol(symbol_) & mask;
+
+    // the index is kept at most half full, so an empty slot is always reached
+    while( slots[slot] != DOES_NOT_CONTAIN && positions[slots[slot]].equity.getSymbol() != symbol_ )
+        slot = (slot + 1) & mask;
+
+    return slot;
+}
+
+template<FeeModel FeePolicy>
+void BasicPortfolio<FeePolicy>::growIndex()
+{
+    slots.assign(slots.size() * 2, DOES_NOT_CONTAIN);
+
+    for( int i = 0; i < positions.size(); i++)
+        slots[findSlot(positions[i].equity.getSymbol())] = i;
+}
+
+template<FeeModel FeePolicy>
+int BasicPortfolio<FeePolicy>::containsTicker(const std::string& ticker_) const
+{
+    return containsSymbol(findSymbol(ticker_)); // a ticker that was never interned cannot be held
+}
+
+template<FeeModel FeePolicy>
+int BasicPortfolio<FeePolicy>::containsSymbol(const SymbolId symbol_) const
+{
+    return slots[findSlot(symbol_)];
+}
+
+template<FeeModel FeePolicy>
+int BasicPortfolio<FeePolicy>::addEquity(const SymbolId symbol_, const int quantity, const Money cost)
+{
+    /*
+    IMPORTANT: does not check validity of symbol_, only call in TwsApi callback to ensure the ticker exists
+    */
+    std::size_t slot = findSlot(symbol_);
+    
+    if( slots[slot] == DOES_NOT_CONTAIN) // if not already holding symbol_
+        return addEquity(LiveEquity(symbol_), quantity, cost);
+
+    // if already holding ticker, add quantity of shares
+    Position& position = positions[slots[slot]];
+
+    unmark(position);
+    position.shares += quantity;
+    position.cost_basis += cost;
+    mark(position);
+
+    changed(slots[slot]);
+
+    return slots[slot];
+}
+
+template<FeeModel FeePolicy>
+int BasicPortfolio<FeePolicy>::addEquity(const LiveEquity& eq, const int quantity, const Money cost)
+{
+    /*
+    IMPORTANT: does not check validity of the ticker, only call in TwsApi callback to ensure the ticker exists
+    */
+    std::size_t slot = findSlot(eq.getSymbol());
+    
+    if( slots[slot] != DOES_NOT_CONTAIN) // if already holding ticker, add quantity of shares
+    {
+        Position& position = positions[slots[slot]];
+
+        unmark(position);
+        position.shares += quantity;
+        position.cost_basis += cost;
+        mark(position);
+
+        changed(slots[slot]);
+
+        return slots[slot];
+    }
+
+    positions.push_back(Position(eq, quantity, cost));
+    slots[slot] = positions.size() - 1;
+
+    mark(positions.back());
+    changed(positions.size() - 1);
+
+    if( positions.size() * 2 > slots.size() )
+        growIndex();
+
+    return positions.size() - 1;
+}
+
+template<FeeModel FeePolicy>
+void BasicPortfolio<FeePolicy>::removeEquity(const int index, const int quantity)
+{
+    Position& position = positions[index];
+
+    unmark(position);
+
+    // average cost, selling every share leaves exactly zero
+    position.cost_basis -= position.shares > 0 ? position.cost_basis.scaledBy(quantity, position.shares) : Money();
+    position.shares -= quantity;
+
+    mark(position);
+
+    changed(index);
+}
+
+template<FeeModel FeePolicy>
+int BasicPortfolio<FeePolicy>::buyEquity(const std::string& ticker_, const int num_shares_buy, const double price, const bool verbose)
+{
+    return buyEquity(ticker_, num_shares_buy, Price::fromDouble(price), verbose);
+}
+
+template<FeeModel FeePolicy>
+int BasicPortfolio<FeePolicy>::buyEquity(const LiveEquity &eq, const int num_shares_buy, const double price, const bool verbose)
+{
+    return buyEquity(eq, num_shares_buy, Price::fromDouble(price), verbose);
+}
+
+template<FeeModel FeePolicy>
+int BasicPortfolio<FeePolicy>::sellEquity(const std::string& ticker_, const int num_shares_sell, const double price, const bool verbose)
+{
+    return sellEquity(ticker_, num_shares_sell, Price::fromDouble(price), verbose);
+}
+
+template<FeeModel FeePolicy>
+int BasicPortfolio<FeePolicy>::buyEquity(const SymbolId symbol_, const int num_shares_buy, const double price, const bool verbose)
+{
+    return buyEquity(symbol_, num_shares_buy, Price::fromDouble(price), verbose);
+}
+
+template<FeeModel FeePolicy>
+int BasicPortfolio<FeePolicy>::sellEquity(const SymbolId symbol_, const int num_shares_sell, const double price, const bool verbose)
+{
+    return sellEquity(symbol_, num_shares_sell, Price::fromDouble(price), verbose);
+}
+
+template<FeeModel FeePolicy>
+int BasicPortfolio<FeePolicy>::buyEquity(const std::string& ticker_, const int num_shares_buy, const Price price, const bool verbose)
+{
+    return buyEquity(internSymbol(ticker_), num_shares_buy, price, verbose);
+}
+
+template<FeeModel FeePolicy>
+int BasicPortfolio<FeePolicy>::sellEquity(const std::string& ticker_, const int num_shares_sell, const Price price, const bool verbose)
+{
+    SymbolId symbol_ = findSymbol(ticker_);
+
+    if( symbol_ == INVALID_SYMBOL ) // never interned, so never bought
+    {
+        if ( verbose )
+        {
+            std::cout << std::endl << "---------- Sale Details ----------" << std::endl;
+            std::cout << "Portfolio does not contain: " << ticker_ << std::endl; 
+            std::cout << "--------------------------------------" << std::endl;
+        }
+
+        return reject(ticker_, SELL, num_shares_sell, price, TICKER_NOT_IN_PORTFOLIO);
+    }
+
+    return sellEquity(symbol_, num_shares_sell, price, verbose);
+}
+
+template<FeeModel FeePolicy>
+int BasicPortfolio<FeePolicy>::buyEquity(const SymbolId symbol_, const int num_shares_buy, const Price price, const bool verbose)
+{
+    /*
+    Conditions to buy:
+    - must have enough money
+    - ticker must exist (might check this when I call it in eclient and historical data)
+    */
+
+    checkJournalable(symbol_);
+
+    Money commission = getCommission(BUY, num_shares_buy, price);
+
+    Money cost = price * num_shares_buy + commission;
+
+    if ( cash <= cost)
+    {
+        if ( verbose )
+        {
+            std::cout << std::endl << "---------- Purchase Details ----------" << std::endl;
+            std::cout << "Insufficient Funds" << std::endl;
+            std::cout << "--------------------------------------" << std::endl;
+        }
+
+        return reject(symbol_, BUY, num_shares_buy, price, INSUFFICIENT_FUNDS);
+    }
+
+    cash -= cost; // pay for stock + commission
+
+    addEquity(symbol_, num_shares_buy, price * num_shares_buy);
+
+    if( verbose )
+    {
+        std::cout << std::endl << "---------- Purchase Details ----------" << std::endl;
+        std::cout << "Ticker: " << symbolTicker(symbol_) 
+                  << ", Number of Shares: " << num_shares_buy
+                  << ", Gross Cost: " << (price * num_shares_buy).toDouble() 
+                  << ", Commission: " << commission.toDouble() 
+                  << ", Total Cost: " << cost.toDouble() << std::endl;
+        std::cout << "--------------------------------------" << std::endl;
+    }
+
+    return filled(symbol_, BUY, num_shares_buy, price, commission);
+}
+
+template<FeeModel FeePolicy>
+int BasicPortfolio<FeePolicy>::buyEquity(const LiveEquity &eq, const int num_shares_buy, const Price price, const bool verbose)
+{
+    /*
+    Conditions to buy:
+    - must have enough money
+    - ticker must exist (might check this when I call it in eclient and historical data)
+    */
+
+    checkJournalable(eq.getSymbol());
+
+    Money commission = getCommission(BUY, num_shares_buy, price);
+
+    Money cost = price * num_shares_buy + commission;
+
+    if ( cash <= cost)
+    {
+        if ( verbose )
+        {
+            std::cout << std::endl << "---------- Purchase Details ----------" << std::endl;
+            std::cout << "Insufficient Funds" << std::endl;
+            std::cout << "--------------------------------------" << std::endl;
+        }
+        return reject(eq.getSymbol(), BUY, num_shares_buy, price, INSUFFICIENT_FUNDS);
+    }
+
+    cash -= cost; // pay for stock + commission
+
+    addEquity(eq, num_shares_buy, price * num_shares_buy);
+
+    if( verbose )
+    {
+        std::cout << std::endl << "---------- Purchase Details ----------" << std::endl;
+        std::cout << "Ticker: " << eq.getTicker() 
+                  << ", Number of Shares: " << num_shares_buy
+                  << ", Gross Cost: " << (price * num_shares_buy).toDouble() 
+                  << ", Commission: " << commission.toDouble() 
+                  << ", Total Cost: " << cost.toDouble() << std::endl;
+        std::cout << "--------------------------------------" << std::endl;
+    }
+
+    return filled(eq.getSymbol(), BUY, num_shares_buy, price, commission);
+}
+
+template<FeeModel FeePolicy>
+int BasicPortfolio<FeePolicy>::sellEquity(const SymbolId symbol_, const int num_shares_sell, const Price price, const bool verbose)
+{
+    /*
+    Conditions to sell:
+    - must have enough shares
+    - portfolio must contain equity with symbol symbol_
+    */
+
+    checkJournalable(symbol_);
+
+    int index = containsSymbol(symbol_);
+
+    // if( ( index != DOES_NOT_CONTAIN ) && ( num_shares[index] >= num_shares_sell ) ) // if ticker is in portfolio, and there are enough shares
+    // {
+
+    //     int commission = getCommission(num_shares_sell);
+
+    //     double proceeds = num_shares_sell*price - commission;
+
+    //     cash += proceeds; // add cash from sale
+
+    //     removeEquity(index, num_shares_sell); // remove shares
+
+    //     if( verbose )
+    //     {
+    //         std::cout << std::endl << "---------- Sale Details ----------" << std::endl;
+    //         std::cout << "Ticker: " << ticker_ 
+    //                 << ", Number of Shares: " << num_shares_sell
+    //                 << ", Gross Proceeds: " << (num_shares_sell * price) 
+    //                 << ", Commission: " << commission 
+    //                 << " Net Proceeds: " << proceeds << std::endl;
+    //         std::cout << "--------------------------------------" << std::endl;
+    //     }
+    //     return SUCCESSFUL_TRADE;
+    // }
+
+    // if ( verbose )
+    // {
+    //     std::cout << std::endl << "---------- Sale Details ----------" << std::endl;
+    //     std::cout << "Insufficient Shares, Number of Shares Held: " << num_shares[index]; // << ", Number of Shares Attempted to Sell: " << num_shares_sell << std::endl;
+    //     std::cout << "--------------------------------------" << std::endl;
+    // }
+        
+    // return INSUFFICIENT_SHARES;
+
+    /*-----*/
+
+    if( index == DOES_NOT_CONTAIN )
+    {
+        if ( verbose )
+        {
+            std::cout << std::endl << "---------- Sale Details ----------" << std::endl;
+            std::cout << "Portfolio does not contain: " << symbolTicker(symbol_) << std::endl; 
+            std::cout << "--------------------------------------" << std::endl;
+        }
+
+        return reject(symbol_, SELL, num_shares_sell, price, TICKER_NOT_IN_PORTFOLIO);
+    }
+
+    else if( positions[index].shares < num_shares_sell )
+    {
+        if ( verbose )
+        {
+            std::cout << std::endl << "---------- Sale Details ----------" << std::endl;
+            std::cout << "Insufficient Shares, Number of Shares Held: " << positions[index].shares << std::endl; // << ", Number of Shares Attempted to Sell: " << num_shares_sell << std::endl;
+            std::cout << "--------------------------------------" << std::endl;
+        }
+        
+        return reject(symbol_, SELL, num_shares_sell, price, INSUFFICIENT_SHARES);
+    }
+
+    Money commission = getCommission(SELL, num_shares_sell, price);
+
+    Money proceeds = price * num_shares_sell - commission;
+
+    cash += proceeds; // add cash from sale
+
+    removeEquity(index, num_shares_sell); // remove shares
+
+    if( verbose )
+    {
+        std::cout << std::endl << "---------- Sale Details ----------" << std::endl;
+        std::cout << "Ticker: " << symbolTicker(symbol_) 
+                  << ", Number of Shares: " << num_shares_sell
+                  << ", Gross Proceeds: " << (price * num_shares_sell).toDouble() 
+                  << ", Commission: " << commission.toDouble() 
+                  << " Net Proceeds: " << proceeds.toDouble() << std::endl;
+        std::cout << "--------------------------------------" << std::endl;
+    }
+    return filled(symbol_, SELL, num_shares_sell, price, commission);
+}
+
+/*---------- BATCH EXECUTION ----------*/
+
+template<FeeModel FeePolicy>
+int BasicPortfolio<FeePolicy>::executeBatch(std::span<const Order> orders, std::span<int> results, const bool all_or_nothing)
+{
+    if( results.size() < orders.size() )
+        throw std::invalid_argument("executeBatch needs one result per order");
+
+    bool invalid_sides = false;
+
+    for( const Order& order : orders )
+    {
+        checkJournalable(order.symbol);
+        invalid_sides = invalid_sides || ( order.side != BUY && order.side != SELL );
+    }
+
+    /*
+    an order that is neither a buy nor a sale is never priced or filled, it is INVALID_ORDER,
+    and with all_or_nothing the rest of its batch is BATCH_REJECTED as it cannot fill whole
+    */
+    if( invalid_sides )
+    {
+        for( std::size_t i = 0; i < orders.size(); i++ )
+        {
+            const Order& order = orders[i];
+
+            if( order.side != BUY && order.side != SELL )
+                results[i] = reject(order.symbol, order.side, order.quantity, order.price, INVALID_ORDER);
+            else if( all_or_nothing )
+                results[i] = reject(order.symbol, order.side, order.quantity, order.price, BATCH_REJECTED);
+        }
+
+        if( all_or_nothing )
+            return 0;
+    }
+
+    // every commission once, both the validation and the execution use them
+    batch_commissions.resize(orders.size());
+
+    for( std::size_t i = 0; i < orders.size(); i++ )
+    {
+        const Order& order = orders[i];
+        batch_commissions[i] = order.side == BUY || order.side == SELL ? getCommission(order.side, order.quantity, order.price) : Money();
+    }
+
+    if( all_or_nothing )
+    {
+        /*
+        validate the whole batch before touching anything with the checks the execution below makes:
+        every sale against a held position and its shares less the earlier sales of the batch, then the
+        cash once every order is netted. Sales run first, so no buy sees less cash than the netted
+        total, which must stay above zero like buyEquity's
+        */
+        const std::int64_t not_held = std::numeric_limits<std::int64_t>::min();
+        Money net_cash = cash;
+        bool valid = true;
+        bool buys = false;
+        std::unordered_map<SymbolId, std::int64_t> batch_shares;
+        batch_shares.reserve(orders.size());
+
+        for( std::size_t i = 0; i < orders.size() && valid; i++ )
+        {
+            const Order& order = orders[i];
+
+            if( order.side == BUY )
+            {
+                net_cash -= order.price * order.quantity + batch_commissions[i];
+                buys = true;
+                continue;
+            }
+
+            auto inserted = batch_shares.emplace(order.symbol, 0);
+
+            if( inserted.second )
+            {
+                int index = containsSymbol(order.symbol);
+                inserted.first->second = index == DOES_NOT_CONTAIN ? not_held : positions[index].shares;
+            }
+
+            valid = inserted.first->second != not_held && inserted.first->second >= order.quantity;
+
+            net_cash += order.price * order.quantity - batch_commissions[i];
+            inserted.first->second -= order.quantity;
+        }
+
+        if( !valid || (buys && net_cash <= Money()) )
+        {
+            for( std::size_t i = 0; i < orders.size(); i++ )
+                results[i] = reject(orders[i].symbol, orders[i].side, orders[i].quantity, orders[i].price, BATCH_REJECTED);
+
+            return 0;
+        }
+    }
+
+    int num_filled = 0;
+
+    // sales first, then buys, each in the order given
+    for( int pass = 0; pass < 2; pass++ )
+    {
+        const int side = pass == 0 ? SELL : BUY;
+
+        for( std::size_t i = 0; i < orders.size(); i++ )
+        {
+            const Order& order = orders[i];
+
+            if( order.side != side )
+                continue;
+
+            const Money commission = batch_commissions[i];
+            const Money gross = order.price * order.quantity;
+
+            if( order.side == BUY )
+            {
+                Money cost = gross + commission;
+
+                // validated batches already checked the netted cash
+                if( !all_or_nothing && cash <= cost )
+                {
+                    results[i] = reject(order.symbol, BUY, order.quantity, order.price, INSUFFICIENT_FUNDS);
+                    continue;
+                }
+
+                cash -= cost;
+                addEquity(order.symbol, order.quantity, gross);
+            }
+            else
+            {
+                int index = containsSymbol(order.symbol);
+
+                if( index == DOES_NOT_CONTAIN )
+                {
+                    results[i] = reject(order.symbol, SELL, order.quantity, order.price, TICKER_NOT_IN_PORTFOLIO);
+                    continue;
+                }
+                else if( positions[index].shares < order.quantity )
+                {
+                    results[i] = reject(order.symbol, SELL, order.quantity, order.price, INSUFFICIENT_SHARES);
+                    continue;
+                }
+
+                cash += gross - commission;
+                removeEquity(index, order.quantity);
+            }
+
+            results[i] = filled(order.symbol, order.side, order.quantity, order.price, commission);
+            num_filled++;
+        }
+    }
+
+    return num_filled;
+}
+
+} // end namespace
+
+#endif // PORTFOLIO_TPP
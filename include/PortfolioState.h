@@ -0,0 +1,142 @@
+/**
+ * @file    PortfolioState.h
+ * @brief   Defines the PortfolioStateBuffer class, lock-free published copies of a Portfolio.
+ *
+ * This file contains the declaration of PortfolioStateBuffer, a seqlock written by the
+ * single thread that applies fills and read by any number of monitoring or risk
+ * threads. The writer bumps a sequence number to odd, stores only what changed (the
+ * totals and the one position slot a fill touched) and bumps it back to even, it never
+ * waits for anyone. A reader copies everything and retries if the sequence moved, so
+ * every PortfolioState it returns matches the Portfolio between two mutations.
+ *
+ * When the position table outgrows its block a bigger one is published and the old
+ * one is retired but kept alive, a reader still copying it then simply retries.
+ *
+ * @author  Benny Zaionz
+ * @date    2026-10-18
+ * @version 1.0
+ */
+
+#ifndef PORTFOLIO_STATE_H
+#define PORTFOLIO_STATE_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "FixedPoint.h"
+#include "SymbolTable.h"
+
+namespace AlgoTrading
+{
+
+/*---------- READER COPIES ----------*/
+
+struct PositionState
+{
+    SymbolId symbol;
+    int shares;
+    Money cost_basis;
+    Price last; // Price::missing() before the first price
+};
+
+struct PortfolioState
+{
+    std::uint64_t version; // number of writes published so far, increases with every mutation
+    Money cash;
+    Money market_value;
+    Money unrealized_pnl;
+    std::vector<PositionState> positions; // same order as Portfolio::getPositions()
+
+    Money getValue() const { return cash + market_value; }
+};
+
+/*---------- SEQLOCK BUFFER ----------*/
+
+class PortfolioStateBuffer
+{
+    private:
+
+        struct Slot
+        {
+            std::atomic<SymbolId> symbol;
+            std::atomic<int> shares;
+            std::atomic<std::int64_t> cost_basis; // ticks
+            std::atomic<std::int64_t> last;
+        };
+
+        struct Block
+        {
+            std::size_t capacity;
+            std::unique_ptr<Slot[]> slots;
+
+            Block(const std::size_t capacity_): capacity(capacity_), slots(new Slot[capacity_]) {}
+        };
+
+        std::atomic<std::uint64_t> sequence; // odd while the writer is storing
+        std::atomic<std::int64_t> cash;
+        std::atomic<std::int64_t> market_value;
+        std::atomic<std::int64_t> unrealized_pnl;
+        std::atomic<int> num_positions;
+        std::atomic<Block*> current;
+
+        std::vector<std::unique_ptr<Block>> blocks; // writer only, every block ever published, the last one is current
+
+    public:
+
+        /*---------- CONSTRUCTOR ----------*/
+
+        PortfolioStateBuffer();
+
+        PortfolioStateBuffer(const PortfolioStateBuffer&) = delete;
+        PortfolioStateBuffer& operator=(const PortfolioStateBuffer&) = delete;
+
+        /*---------- WRITER (ONE THREAD) ----------*/
+
+        // every store between beginWrite and endWrite is seen by readers all at once
+        void beginWrite();
+        void endWrite();
+
+        void writeTotals(const Money cash_, const Money market_value_, const Money unrealized_pnl_);
+        void writePosition(const int index, const PositionState& position); // index <= number of positions, grows the table by one at the end
+
+        /*---------- READERS (ANY THREAD) ----------*/
+
+        bool tryRead(PortfolioState& out) const; // false if a write overlapped, out is then unspecified
+        void read(PortfolioState& out) const; // retries until consistent, reuses out.positions' memory
+        PortfolioState read() const;
+
+        std::uint64_t getVersion() const { return sequence.load(std::memory_order_acquire) / 2; }
+};
+
+/*---------- PORTFOLIO MEMBER ----------*/
+
+class PortfolioStatePublisher
+{
+    /*
+    owned by a Portfolio, inactive (and free) until the first reader asks for the buffer,
+    a copied Portfolio is a separate writer so the copy starts inactive instead of sharing it
+    */
+
+    private:
+
+        std::shared_ptr<PortfolioStateBuffer> buffer;
+
+    public:
+
+        PortfolioStatePublisher() = default;
+        PortfolioStatePublisher(const PortfolioStatePublisher&): buffer{} {}
+        PortfolioStatePublisher& operator=(const PortfolioStatePublisher&) { buffer.reset(); return *this; }
+        PortfolioStatePublisher(PortfolioStatePublisher&&) = default;
+        PortfolioStatePublisher& operator=(PortfolioStatePublisher&&) = default;
+
+        bool isActive() const { return buffer != nullptr; }
+        PortfolioStateBuffer* get() const { return buffer.get(); }
+        std::shared_ptr<const PortfolioStateBuffer> share() const { return buffer; }
+        void activate() { if( buffer == nullptr ) buffer = std::make_shared<PortfolioStateBuffer>(); }
+};
+
+} // namespace
+
+#endif // PORTFOLIO_STATE_H
@@ -0,0 +1,149 @@
+/**
+ * @file    RiskEngine.h
+ * @brief   Defines the RiskEngine class, pre-trade risk checks in front of a Portfolio.
+ *
+ * This file contains the declaration of the RiskEngine class. Every order is checked
+ * against a maximum order size and notional, a per-symbol position limit, gross and net
+ * notional caps over all symbols, and a fat-finger price band around the current bid/ask.
+ * Limits are looked up in a table indexed directly by SymbolId and the exposures they are
+ * compared with are kept up to date incrementally on every fill and every price update,
+ * so a check is a handful of loads and compares with no allocation, hashing or locking.
+ * See bench/RiskEngine_bench.cpp for the latency.
+ *
+ * @author  Benny Zaionz
+ * @date    2026-10-18
+ * @version 1.0
+ */
+
+#ifndef RISK_ENGINE_H
+#define RISK_ENGINE_H
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "Portfolio.h"
+
+namespace AlgoTrading
+{
+
+enum RiskReject{ RISK_ACCEPTED, RISK_ORDER_SIZE, RISK_ORDER_NOTIONAL, RISK_POSITION_LIMIT,
+                 RISK_GROSS_LIMIT, RISK_NET_LIMIT, RISK_PRICE_BAND, RISK_NO_MARKET };
+
+const std::int64_t NO_LIMIT = std::numeric_limits<std::int64_t>::max();
+
+struct RiskLimits
+{
+    // the defaults allow everything except a price more than 5% through the market
+    int max_order_shares = std::numeric_limits<int>::max(); // per order, symbols without their own limit
+    std::int64_t max_position_shares = NO_LIMIT; // absolute shares held, symbols without their own limit
+    Money max_order_notional = Money::fromTicks(NO_LIMIT);
+    Money max_gross_notional = Money::fromTicks(NO_LIMIT); // sum of |position * mark| over every symbol
+    Money max_net_notional = Money::fromTicks(NO_LIMIT); // |sum of position * mark|
+    std::int64_t price_band_bps = 500; // buys at most this far above the ask, sells at most this far below the bid
+    bool require_market = true; // reject orders in symbols that have no bid/ask yet
+};
+
+struct RiskResult
+{
+    int risk; // enum RiskReject
+    int status; // enum TradeStatus, RISK_REJECTED if risk != RISK_ACCEPTED
+};
+
+class RiskEngine
+{
+    private:
+
+        struct SymbolRisk
+        {
+            int max_order_shares; // -1 for the firm wide limit
+            std::int64_t max_position_shares; // -1 for the firm wide limit
+            std::int64_t position; // shares, negative when short
+            Price bid;
+            Price ask;
+            Price mark; // price the exposure is valued at: last trade, else mid, else the first fill
+            Money notional; // position * mark, zero while there is no mark
+        };
+
+        RiskLimits limits;
+        std::vector<SymbolRisk> symbols; // indexed by SymbolId, grown on demand
+
+        // running sums over symbols, updated by every fill and mark change
+        Money gross_notional;
+        Money net_notional;
+
+        SymbolRisk& getSymbol(const SymbolId symbol_);
+        void setNotional(SymbolRisk& risk, const Money notional_);
+
+    public:
+
+        /*---------- CONSTRUCTOR ----------*/
+
+        RiskEngine(const RiskLimits& limits_ = RiskLimits());
+
+        /*---------- LIMITS ----------*/
+
+        void setLimits(const RiskLimits& limits_); // firm wide, symbols keep their own limits set below
+        void setSymbolLimits(const SymbolId symbol_, const int max_order_shares_, const std::int64_t max_position_shares_);
+        const RiskLimits& getLimits() const { return limits; }
+
+        /*---------- MARKET DATA AND FILLS ----------*/
+
+        void updateMarket(const SymbolId symbol_, const Price bid_, const Price ask_, const Price last_ = Price::missing());
+        void updateMarket(const LiveEquity& eq);
+        void onFill(const SymbolId symbol_, const int side, const int quantity, const Price price);
+
+        // replaces every tracked position with portfolio's, use once when attaching to a Portfolio that already holds shares
+        template<typename PortfolioType>
+        void syncPositions(const PortfolioType& portfolio);
+
+        /*---------- CHECKS ----------*/
+
+        int check(const Order& order) const; // enum RiskReject, changes nothing
+
+        // check then, if accepted, buyEquity / sellEquity on portfolio and record the fill
+        template<typename PortfolioType>
+        RiskResult submit(PortfolioType& portfolio, const Order& order);
+
+        /*---------- GETTERS ----------*/
+
+        Money getGrossNotional() const { return gross_notional; }
+        Money getNetNotional() const { return net_notional; }
+        std::int64_t getPosition(const SymbolId symbol_) const { return symbol_ < symbols.size() ? symbols[symbol_].position : 0; }
+};
+
+/*---------- PORTFOLIO TEMPLATES ----------*/
+
+template<typename PortfolioType>
+void RiskEngine::syncPositions(const PortfolioType& portfolio)
+{
+    for( SymbolRisk& risk : symbols )
+    {
+        risk.position = 0;
+        setNotional(risk, Money());
+    }
+
+    for( const Position& position : portfolio.getPositions() )
+        onFill(position.equity.getSymbol(), BUY, position.shares, position.equity.getLastPrice());
+}
+
+template<typename PortfolioType>
+RiskResult RiskEngine::submit(PortfolioType& portfolio, const Order& order)
+{
+    const int risk = check(order);
+
+    if( risk != RISK_ACCEPTED )
+        return RiskResult{ risk, RISK_REJECTED };
+
+    const int status = order.side == BUY ? portfolio.buyEquity(order.symbol, order.quantity, order.price)
+                                         : portfolio.sellEquity(order.symbol, order.quantity, order.price);
+
+    if( status == SUCCESSFUL_TRADE )
+        onFill(order.symbol, order.side, order.quantity, order.price);
+
+    return RiskResult{ RISK_ACCEPTED, status };
+}
+
+} // namespace
+
+#endif // RISK_ENGINE_H
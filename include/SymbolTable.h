@@ -0,0 +1,71 @@
+/**
+ * @file    SymbolTable.h
+ * @brief   Defines the SymbolTable class, the process-wide registry of ticker symbols.
+ *
+ * This file contains the declaration of the SymbolTable class and the SymbolId type.
+ * Each distinct ticker string is interned once, at load or subscription time, and is
+ * afterwards carried around as a 32 bit SymbolId. LiveEquity, Portfolio and
+ * HistoricalEquityData compare and hash ids, the string is only looked up again for
+ * printing and I/O. Ids are never reused and the strings they refer to are never moved,
+ * so references returned by getTicker() stay valid for the life of the process.
+ *
+ * @author  Benny Zaionz
+ * @date    2026-10-18
+ * @version 1.0
+ */
+
+#ifndef SYMBOL_TABLE_H
+#define SYMBOL_TABLE_H
+
+#include <cstdint>
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace AlgoTrading
+{
+
+using SymbolId = std::uint32_t;
+
+const SymbolId INVALID_SYMBOL = UINT32_MAX;
+
+class SymbolTable
+{
+    private:
+
+        mutable std::shared_mutex mutex; // readers share, intern() of a new ticker is exclusive
+
+        std::deque<std::string> tickers; // indexed by SymbolId, a deque never moves its elements
+        std::unordered_map<std::string_view, SymbolId> ids; // keys view into tickers
+
+        SymbolTable() = default;
+
+    public:
+
+        SymbolTable(const SymbolTable&) = delete;
+        SymbolTable& operator=(const SymbolTable&) = delete;
+
+        static SymbolTable& instance();
+
+        /*---------- INTERNING ----------*/
+
+        SymbolId intern(std::string_view ticker_); // id of ticker_, registering it on first use
+        SymbolId find(std::string_view ticker_) const; // INVALID_SYMBOL if ticker_ was never interned
+
+        /*---------- GETTERS ----------*/
+
+        const std::string& getTicker(const SymbolId symbol) const; // throws std::out_of_range for an unknown id
+        std::size_t size() const;
+};
+
+/*---------- SHORTHANDS ----------*/
+
+inline SymbolId internSymbol(std::string_view ticker_) { return SymbolTable::instance().intern(ticker_); }
+inline SymbolId findSymbol(std::string_view ticker_) { return SymbolTable::instance().find(ticker_); }
+inline const std::string& symbolTicker(const SymbolId symbol) { return SymbolTable::instance().getTicker(symbol); }
+
+} // namespace
+
+#endif // SYMBOL_TABLE_H
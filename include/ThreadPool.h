@@ -0,0 +1,87 @@
+/**
+ * @file    ThreadPool.h
+ * @brief   Defines the ThreadPool class, a work-stealing pool for independent indexed tasks.
+ *
+ * This file contains the declaration of the ThreadPool class. parallelFor splits the
+ * indices [0, count) into one contiguous range per worker. A worker takes indices from
+ * the front of its own range, and once that is empty it steals the back half of another
+ * worker's range, so tasks of very different lengths still keep every core busy. Each
+ * range is one atomic word on its own cache line, taking and stealing are single
+ * compare-and-swaps with no lock, the pool only sleeps on a mutex between calls.
+ *
+ * @author  Benny Zaionz
+ * @date    2026-10-18
+ * @version 1.0
+ */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace AlgoTrading
+{
+
+class ThreadPool
+{
+    private:
+
+        struct alignas(64) WorkRange
+        {
+            std::atomic<std::uint64_t> bounds; // begin in the high 32 bits, end in the low 32
+        };
+
+        std::vector<std::thread> threads;
+        std::unique_ptr<WorkRange[]> ranges;
+
+        // one parallelFor at a time, workers sleep on wake between them
+        std::mutex run_mutex;
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable finished;
+        std::uint64_t generation;
+        int num_working;
+        bool stopping;
+
+        const std::function<void(int, int)>* job;
+        std::atomic<bool> failed;
+        std::exception_ptr error; // first exception thrown by job, rethrown by parallelFor
+
+        void workerLoop(const int worker);
+        void work(const int worker);
+        bool take(const int worker, int& index);
+        bool steal(const int worker, std::uint64_t& seed);
+
+    public:
+
+        /*---------- CONSTRUCTOR ----------*/
+
+        explicit ThreadPool(const int num_threads = 0); // 0 for std::thread::hardware_concurrency()
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /*---------- GETTERS ----------*/
+
+        int getNumThreads() const { return threads.size(); }
+
+        /*---------- RUNNING ----------*/
+
+        // calls fn(index, worker) once for every index in [0, count) and returns when all are done,
+        // worker is in [0, getNumThreads()) so fn can keep per-worker scratch state. If fn throws
+        // no new indices are started and the first exception is rethrown here
+        void parallelFor(const int count, const std::function<void(int, int)>& fn);
+};
+
+} // namespace
+
+#endif // THREAD_POOL_H
@@ -0,0 +1,183 @@
+/**
+ * @file    TradeJournal.h
+ * @brief   Defines the TradeJournal class, an append-only binary log of Portfolio events.
+ *
+ * This file contains the journal file layout and the declaration of the TradeJournal
+ * class. A journal is a 64 byte header followed by 64 byte JournalRecords, one per fill,
+ * rejection or cash adjustment, numbered from 1. Records are buffered and written in
+ * groups (group commit), so the hot path only copies 64 bytes. Tickers are stored inline
+ * because SymbolIds only mean something inside one process. Because every record has the
+ * same size, a journal can be memory mapped and replayed without parsing, which is how
+ * replay() rebuilds a Portfolio.
+ *
+ * Durability: a record survives a process or OS crash once flush() has returned, flush()
+ * writes the pending group and syncs it to disk (fdatasync, _commit on Windows). It runs
+ * by itself when group_size records are pending or when a record is made more than
+ * max_delay after the oldest pending one, so while records keep coming at most group_size
+ * records or max_delay of them are at risk. Nothing flushes an idle journal, call flush()
+ * at the points that must be durable (end of an event loop pass, before acknowledging).
+ *
+ * @author  Benny Zaionz
+ * @date    2026-10-18
+ * @version 1.0
+ */
+
+#ifndef TRADE_JOURNAL_H
+#define TRADE_JOURNAL_H
+
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "FixedPoint.h"
+#include "MappedFile.h"
+#include "SymbolTable.h"
+
+namespace AlgoTrading
+{
+
+const char JOURNAL_MAGIC[8] = { 'A', 'T', 'J', 'R', 'N', 'L', 0, 0 };
+const std::uint32_t JOURNAL_VERSION = 1;
+const int JOURNAL_MAX_TICKER = 15; // plus the terminating null
+const std::size_t DEFAULT_JOURNAL_GROUP = 256; // records per write
+const std::int64_t DEFAULT_JOURNAL_DELAY = 10000000; // nanoseconds a record may wait for its group, 10 ms
+
+enum JournalRecordType{ JOURNAL_BUY, JOURNAL_SELL, JOURNAL_REJECTION, JOURNAL_CASH_ADJUSTMENT };
+
+struct JournalFileHeader
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t record_size;
+    std::uint8_t padding[64 - 8 - 4 - 4];
+};
+
+struct JournalRecord
+{
+    std::uint64_t sequence; // 1 for the first record of the file
+    std::int64_t timestamp; // nanoseconds since the epoch (system clock) when the record was made
+    std::uint16_t type; // enum JournalRecordType
+    std::uint16_t side; // enum OrderSide, for fills and rejections
+    std::int32_t status; // enum TradeStatus, for rejections
+    std::int32_t quantity;
+    std::int32_t reserved;
+    std::int64_t price; // ticks
+    std::int64_t amount; // ticks, the commission of a fill or the change of a cash adjustment
+    char ticker[JOURNAL_MAX_TICKER + 1];
+};
+
+static_assert(sizeof(JournalFileHeader) == 64, "JournalFileHeader must stay 64 bytes");
+static_assert(sizeof(JournalRecord) == 64, "JournalRecord must stay 64 bytes");
+
+class TradeJournal
+{
+    private:
+
+        int fd; // file descriptor opened for appending
+        std::string path;
+        std::vector<JournalRecord> pending; // not yet written
+        std::size_t group_size;
+        std::int64_t max_delay;
+        std::uint64_t next_sequence;
+        std::uint64_t synced_size; // bytes of the file known written and synced, a failed flush cuts back to it
+
+        std::uint64_t append(JournalRecord& record, std::string_view ticker_);
+
+    public:
+
+        /*---------- CONSTRUCTOR ----------*/
+
+        // creates path_ or appends to it, a torn record left at the end by a crash is cut off and a file
+        // left with no complete header (a crash while creating it) is started again,
+        // throws std::runtime_error if the file cannot be opened or is not a journal
+        TradeJournal(const std::string& path_,
+                     const std::size_t group_size_ = DEFAULT_JOURNAL_GROUP,
+                     const std::int64_t max_delay_ = DEFAULT_JOURNAL_DELAY);
+        ~TradeJournal(); // flushes, errors are swallowed, call flush() first to see them
+
+        TradeJournal(const TradeJournal&) = delete;
+        TradeJournal& operator=(const TradeJournal&) = delete;
+
+        /*---------- RECORDING ----------*/
+
+        // each returns the sequence number of the record, tickers longer than JOURNAL_MAX_TICKER throw std::invalid_argument
+        std::uint64_t recordFill(std::string_view ticker_, const int side, const int quantity, const Price price, const Money commission);
+        std::uint64_t recordRejection(std::string_view ticker_, const int side, const int quantity, const Price price, const int status);
+        std::uint64_t recordCashAdjustment(const Money amount);
+
+        // writes and syncs every pending record, throws std::runtime_error if the write fails after
+        // cutting off the part of the group that was written, the records stay pending for a retry
+        void flush();
+
+        /*---------- GETTERS ----------*/
+
+        std::uint64_t getLastSequence() const { return next_sequence - 1; }
+        std::size_t getNumPending() const { return pending.size(); }
+
+        /*---------- REPLAY ----------*/
+
+        /*
+        applies every record with sequence <= up_to to portfolio with replayFill and
+        replayCashAdjustment (rejections change nothing), returns the number of records read.
+        Those do not journal, so a journal attached to portfolio (before or after) is left as
+        it was. Start from a Portfolio with zero cash, the journal holds the starting cash as
+        its first cash adjustment
+        */
+        template<typename PortfolioType>
+        static std::uint64_t replay(const std::string& path, PortfolioType& portfolio, const std::uint64_t up_to = UINT64_MAX);
+
+        static std::vector<JournalRecord> readAll(const std::string& path);
+
+        // the records of a mapped journal, a torn record at the end is left out, throws std::runtime_error if file is not a journal
+        static std::span<const JournalRecord> getRecords(const MappedFile& file, const std::string& path);
+};
+
+/*---------- REPLAY ----------*/
+
+template<typename PortfolioType>
+std::uint64_t TradeJournal::replay(const std::string& path, PortfolioType& portfolio, const std::uint64_t up_to)
+{
+    MappedFile file(path);
+    std::span<const JournalRecord> records = getRecords(file, path);
+
+    // most journals trade a few symbols many times, so remember the last id rather than intern every record
+    char last_ticker[JOURNAL_MAX_TICKER + 1] = {};
+    SymbolId last_symbol = INVALID_SYMBOL;
+
+    std::uint64_t applied = 0;
+
+    for( const JournalRecord& record : records )
+    {
+        if( record.sequence > up_to )
+            break;
+
+        applied++;
+
+        if( record.type == JOURNAL_CASH_ADJUSTMENT )
+        {
+            portfolio.replayCashAdjustment(Money::fromTicks(record.amount));
+            continue;
+        }
+
+        if( record.type != JOURNAL_BUY && record.type != JOURNAL_SELL ) // rejections leave the portfolio as it was
+            continue;
+
+        if( last_symbol == INVALID_SYMBOL || std::memcmp(last_ticker, record.ticker, sizeof(last_ticker)) != 0 )
+        {
+            std::memcpy(last_ticker, record.ticker, sizeof(last_ticker));
+            last_ticker[JOURNAL_MAX_TICKER] = '\0';
+            last_symbol = internSymbol(last_ticker);
+        }
+
+        portfolio.replayFill(last_symbol, record.side, record.quantity, Price::fromTicks(record.price), Money::fromTicks(record.amount));
+    }
+
+    return applied;
+}
+
+} // namespace
+
+#endif // TRADE_JOURNAL_H
@@ -0,0 +1,66 @@
+/**
+ * @file    VectorBacktest.h
+ * @brief   Declares runVectorized, an array-at-a-time backtest for signal strategies.
+ *
+ * This file contains the declarations of runVectorized and of the signal functions
+ * that feed it. A signal strategy is a pure function of the price columns, so instead
+ * of a callback per bar it is evaluated over the whole column into one target position
+ * per bar, and runVectorized turns the targets into fills, cash, commissions and an
+ * equity curve in a few passes over plain arrays.
+ *
+ * The fills follow the event-driven Backtest exactly: a target set at bar i is ordered
+ * the way Backtest::orderTarget orders it, filled on the next bar (or the same one with
+ * FILL_THIS_BAR) at the price BacktestConfig picks, with Portfolio's funds and shares
+ * checks and its commission (IbkrFixedFees) in fixed point. Given the same targets,
+ * the fills, rejections, commissions, cash and final value of the BacktestResult are
+ * identical to Backtest::run with a strategy that calls orderTarget(source, targets[row])
+ * on every bar. The per bar equity curve and so max_drawdown are computed in double
+ * from the unrounded last prices, they differ from the event-driven values by at most
+ * half a tick (0.00005) per share held.
+ *
+ * Requires chronological data with one bar per timestamp and a positive last price on
+ * every bar (std::invalid_argument otherwise), use Backtest for data with gaps.
+ *
+ * @author  Benny Zaionz
+ * @date    2026-10-18
+ * @version 1.0
+ */
+
+#ifndef VECTOR_BACKTEST_H
+#define VECTOR_BACKTEST_H
+
+#include <span>
+
+#include "Backtest_lib.h"
+
+namespace AlgoTrading
+{
+
+/*---------- SIGNALS ----------*/
+
+// every signal writes one target per price (targets at least prices.size() long), 0 until its window is full,
+// prices are rounded to ticks first and summed exactly, a per bar strategy doing the same on Price ticks
+// (in any order) produces the same targets
+
+// shares while the fast simple moving average is above the slow one, flat otherwise
+void movingAverageCrossTargets(std::span<const double> prices, const int fast, const int slow, const int shares, std::span<int> targets);
+
+// mean reversion on the z-score of price against its rolling mean and (population) standard deviation,
+// goes long shares when z < -entry and back to flat once z > -exit. The squares are summed exactly while
+// window * move^2 < 2^63 for the largest move in ticks within a block of about 2048 rows, throws
+// std::invalid_argument beyond that (at a window of 1000 a move of $9.6k)
+void zScoreTargets(std::span<const double> prices, const int window, const double entry, const double exit, const int shares, std::span<int> targets);
+
+/*---------- RUNNING ----------*/
+
+// targets[i] is the position wanted after bar i (at least hist.getSize() long), equity receives the
+// portfolio value after every bar if not empty (at least hist.getSize() long), record_equity and
+// record_fills in config are ignored
+BacktestResult runVectorized(const HistoricalEquityData& hist,
+                             std::span<const int> targets,
+                             const BacktestConfig& config = BacktestConfig(),
+                             std::span<double> equity = {});
+
+} // namespace
+
+#endif // VECTOR_BACKTEST_H
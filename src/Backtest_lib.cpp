@@ -1,3 +1,342 @@
+/**
+ * @file    Backtest_lib.cpp
+ * @brief   Defines the Backtest class functionality.
+ *
+ * This file contains the merge loop of the Backtest class, the order execution
+ * against its Portfolio and the recording of fills, equity and the run summary.
+ *
+ * @author  Benny Zaionz
+ * @date    2026-10-18
+ * @version 1.0
+ */
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <unordered_set>
+
 #include "Backtest_lib.h"
 
-//ehh
\ No newline at end of file
+namespace AlgoTrading
+{
+
+const int PENDING_ORDERS_PER_SOURCE = 4; // reserved up front, grows (once) only for strategies that stack more orders per bar
+
+/*---------- CONSTRUCTOR ----------*/
+
+Backtest::Backtest(const std::vector<const HistoricalEquityData*>& sources_, const BacktestConfig& config_):
+    config(config_),
+    sources{},
+    portfolio(config_.initial_cash),
+    strategy(nullptr),
+    heap{},
+    pending_sources{},
+    datetime(),
+    started(false),
+    num_bars(0),
+    num_fills(0),
+    num_rejected(0),
+    commissions(),
+    peak(),
+    max_drawdown(0),
+    equity_curve{},
+    fills{}
+{
+    std::unordered_set<SymbolId> seen;
+
+    sources.reserve(sources_.size());
+
+    for( const HistoricalEquityData* hist : sources_ )
+    {
+        if( hist == nullptr )
+            throw std::invalid_argument("Backtest source is null");
+
+        if( !seen.insert(hist->getSymbol()).second )
+            throw std::invalid_argument("Backtest has more than one source for: " + hist->getTicker());
+
+        sources.push_back(SourceState{ hist, hist->getSymbol(), 0, -1, 0, 0, {} });
+        sources.back().pending.reserve(PENDING_ORDERS_PER_SOURCE);
+    }
+
+    heap.reserve(sources.size());
+    pending_sources.reserve(sources.size());
+}
+
+int Backtest::getSourceIndex(const SymbolId symbol_) const
+{
+    // linear, there are few sources and strategies should keep the index anyway
+    for( int i = 0; i < sources.size(); i++ )
+        if( sources[i].symbol == symbol_ )
+            return i;
+
+    return NOT_CONTAINED;
+}
+
+/*---------- RUNNING ----------*/
+
+void Backtest::reset()
+{
+    portfolio.reset(config.initial_cash); // keeps the capacity, runs of a sweep allocate nothing new
+
+    std::size_t total_bars = 0;
+
+    for( SourceState& state : sources )
+    {
+        state.position = 0;
+        state.row = -1;
+        state.shares = 0;
+        state.pending_quantity = 0;
+        state.pending.clear();
+
+        total_bars += state.hist->getSize();
+    }
+
+    heap.clear();
+    pending_sources.clear();
+    datetime = DateTime();
+    started = false;
+    num_bars = 0;
+    num_fills = 0;
+    num_rejected = 0;
+    commissions = Money();
+    peak = portfolio.getValueMoney();
+    max_drawdown = 0;
+
+    // every timestamp could be distinct, so this is the most the curve can need
+    equity_curve.clear();
+    if( config.record_equity )
+        equity_curve.reserve(total_bars);
+
+    // one fill per bar, as many as a strategy ordering through orderTarget once per bar can make
+    fills.clear();
+    if( config.record_fills )
+        fills.reserve(total_bars);
+}
+
+BacktestResult Backtest::run(Strategy& strategy_)
+{
+    /*
+    k-way merge: the heap holds the next bar of every other source, the popped source keeps
+    streaming without touching the heap for as long as its next bar still comes first, so a
+    single source (or sources on different sessions) costs no heap operations per bar
+    */
+
+    reset();
+    strategy = &strategy_;
+
+    for( int i = 0; i < sources.size(); i++ )
+    {
+        const HistoricalEquityData& hist = *sources[i].hist;
+
+        if( hist.getSize() > 0 )
+            heap.push_back(MergeEntry{ hist.getDatetimeColumn()[hist.getIndexByTime(0)].getEpoch(), i });
+    }
+
+    std::make_heap(heap.begin(), heap.end(), std::greater<MergeEntry>());
+
+    strategy->onStart(*this);
+
+    while( !heap.empty() )
+    {
+        std::pop_heap(heap.begin(), heap.end(), std::greater<MergeEntry>());
+        MergeEntry next = heap.back();
+        heap.pop_back();
+
+        SourceState& state = sources[next.source];
+        const HistoricalEquityData& hist = *state.hist;
+        std::span<const DateTime> datetimes = hist.getDatetimeColumn();
+
+        while( true )
+        {
+            const int row = hist.getIndexByTime(state.position);
+
+            if( started && next.epoch != datetime.getEpoch() )
+                closeTimestamp();
+
+            started = true;
+            datetime = datetimes[row];
+
+            processBar(next.source, row);
+
+            if( ++state.position == hist.getSize() )
+                break;
+
+            next.epoch = datetimes[hist.getIndexByTime(state.position)].getEpoch();
+
+            if( !heap.empty() && next > heap.front() )
+            {
+                heap.push_back(next);
+                std::push_heap(heap.begin(), heap.end(), std::greater<MergeEntry>());
+                break;
+            }
+        }
+    }
+
+    if( started )
+        closeTimestamp();
+
+    strategy->onEnd(*this);
+    strategy = nullptr;
+
+    BacktestResult result;
+
+    result.initial_value = config.initial_cash;
+    result.final_value = portfolio.getValue();
+    result.total_return = result.initial_value > 0 ? result.final_value / result.initial_value - 1 : 0;
+    result.max_drawdown = max_drawdown;
+    result.commissions = commissions.toDouble();
+    result.num_fills = num_fills;
+    result.num_rejected = num_rejected;
+    result.num_bars = num_bars;
+
+    return result;
+}
+
+void Backtest::closeTimestamp()
+{
+    const Money value = portfolio.getValueMoney();
+
+    if( value > peak )
+        peak = value;
+    else if( peak > Money() )
+        max_drawdown = std::max(max_drawdown, (peak - value).toDouble() / peak.toDouble());
+
+    if( config.record_equity )
+        equity_curve.push_back(EquityPoint{ datetime, portfolio.getCashMoney(), value });
+}
+
+void Backtest::processBar(const int source, const int row)
+{
+    SourceState& state = sources[source];
+
+    state.row = row;
+    num_bars++;
+
+    if( config.fill_timing == FILL_NEXT_BAR && !state.pending.empty() )
+        executePending(source);
+
+    if( state.shares != 0 )
+        markSource(state);
+
+    strategy->onBar(*this, source, state.hist->getRow(row));
+
+    if( config.fill_timing == FILL_THIS_BAR && !pending_sources.empty() )
+        executePendingSources();
+}
+
+void Backtest::markSource(const SourceState& state)
+{
+    const double last = state.hist->getRow(state.row).getLast();
+
+    if( last > 0 )
+        portfolio.updateLast(state.symbol, Price::fromDouble(last));
+}
+
+/*---------- ORDERS ----------*/
+
+void Backtest::order(const int source, const int quantity)
+{
+    if( quantity == 0 )
+        return;
+
+    SourceState& state = sources[source];
+
+    if( state.pending.empty() && config.fill_timing == FILL_THIS_BAR )
+        pending_sources.push_back(source);
+
+    state.pending.push_back(PendingOrder{ quantity > 0 ? BUY : SELL, quantity > 0 ? quantity : -quantity });
+    state.pending_quantity += quantity;
+}
+
+void Backtest::orderTarget(const int source, const int shares)
+{
+    order(source, shares - sources[source].shares - sources[source].pending_quantity);
+}
+
+Price Backtest::fillPrice(const SourceState& state, const int side) const
+{
+    const SnapshotRef bar = state.hist->getRow(state.row);
+
+    if( config.cross_spread )
+    {
+        const double quote = side == BUY ? bar.getAsk() : bar.getBid();
+
+        if( quote > 0 )
+            return Price::fromDouble(quote);
+    }
+
+    const double price = bar.getPrice(config.fill_price_type);
+
+    return price > 0 ? Price::fromDouble(price) : Price::missing();
+}
+
+void Backtest::executePending(const int source)
+{
+    /*
+    orders are taken by index because onFill may place new ones on the same source,
+    those stay pending for the next fill opportunity
+    */
+
+    SourceState& state = sources[source];
+    const int count = state.pending.size();
+    int done = 0;
+
+    for( ; done < count; done++ )
+    {
+        const PendingOrder pending_order = state.pending[done];
+        const Price price = fillPrice(state, pending_order.side);
+
+        if( price.isMissing() ) // wait for a bar with a price
+            break;
+
+        const int status = pending_order.side == BUY ? portfolio.buyEquity(state.symbol, pending_order.quantity, price)
+                                                     : portfolio.sellEquity(state.symbol, pending_order.quantity, price);
+
+        state.pending_quantity -= pending_order.side == BUY ? pending_order.quantity : -pending_order.quantity;
+
+        Money commission;
+
+        if( status == SUCCESSFUL_TRADE )
+        {
+            commission = portfolio.getFees().commission(pending_order.side, pending_order.quantity, price);
+            commissions += commission;
+            state.shares += pending_order.side == BUY ? pending_order.quantity : -pending_order.quantity;
+            num_fills++;
+        }
+        else
+            num_rejected++;
+
+        if( config.record_fills )
+            fills.push_back(BacktestFill{ datetime, source, pending_order.side, pending_order.quantity, price, commission, status });
+
+        if( status == SUCCESSFUL_TRADE )
+        {
+            markSource(state);
+            strategy->onFill(*this, source, pending_order.side, pending_order.quantity, price);
+        }
+    }
+
+    state.pending.erase(state.pending.begin(), state.pending.begin() + done);
+}
+
+void Backtest::executePendingSources()
+{
+    int kept = 0;
+
+    for( int i = 0; i < pending_sources.size(); i++ )
+    {
+        const int source = pending_sources[i];
+        const SourceState& state = sources[source];
+
+        // only on a bar of this timestamp, a source without one waits for its next bar rather than fill at a stale one
+        if( state.row >= 0 && state.hist->getDatetimeColumn()[state.row].getEpoch() == datetime.getEpoch() )
+            executePending(source);
+
+        if( !sources[source].pending.empty() )
+            pending_sources[kept++] = source;
+    }
+
+    pending_sources.resize(kept);
+}
+
+} // namespace
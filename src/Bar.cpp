@@ -13,7 +13,9 @@
  */
 
 #include "Bar.h"
+#include "EquitySnapshot.h"
 
+#include <algorithm>
 #include <iostream>
 
 namespace AlgoTrading
@@ -24,6 +26,44 @@ namespace AlgoTrading
 Bar::Bar(double first_, double last_, double low_, double high_): 
 first(first_), last(last_), low(low_), high(high_) {} 
 
+/*---------- AGGREGATION ----------*/
+
+void Bar::update(const double price)
+{
+    if( price < 0 )
+        return;
+
+    if( isEmpty() )
+    {
+        first = last = low = high = price;
+        return;
+    }
+
+    last = price;
+    low = std::min(low, price);
+    high = std::max(high, price);
+}
+
+void Bar::merge(const Bar& bar)
+{
+    /*
+    a one price bar (a live tick) carries -1 for low and high, so only the parts it has are
+    folded in, the first merge included, and its last widens the range like update() does
+    */
+    if( bar.isEmpty() )
+        return;
+
+    if( isEmpty() )
+        first = last = low = high = bar.getFirst();
+
+    if( bar.getLast() >= 0 )
+        update(bar.getLast());
+    if( bar.getLow() >= 0 )
+        low = std::min(low, bar.getLow());
+    if( bar.getHigh() >= 0 )
+        high = std::max(high, bar.getHigh());
+}
+
 /*---------- PRINTING HELPERS ----------*/
 
 void Bar::print(const int print_type) const
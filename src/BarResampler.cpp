@@ -0,0 +1,157 @@
+/**
+ * @file    BarResampler.cpp
+ * @brief   Defines the BarResampler class functionality.
+ *
+ * This file contains the period arithmetic for every StepSizeUnit and the
+ * incremental aggregation of snapshots into ResampledBars.
+ *
+ * @author  Benny Zaionz
+ * @date    2026-10-18
+ * @version 1.0
+ */
+
+#include <utility>
+
+#include "BarResampler.h"
+
+namespace AlgoTrading
+{
+
+namespace
+{
+
+const std::int64_t EPOCH_DAY_TO_MONDAY = 3; // 1970-01-01 was a Thursday
+
+std::int64_t floorDiv(const std::int64_t a, const std::int64_t b)
+{
+    return a / b - ((a % b != 0) && ((a < 0) != (b < 0)));
+}
+
+std::int64_t secondsPerUnit(const int step_unit)
+{
+    if( step_unit == SECS )
+        return 1;
+    else if( step_unit == MINS )
+        return 60;
+    else if( step_unit == HOURS )
+        return 3600;
+
+    return SECONDS_PER_DAY;
+}
+
+} // anonymous namespace
+
+/*---------- CONSTRUCTOR ----------*/
+
+BarResampler::BarResampler():
+targets{} {}
+
+/*---------- TARGETS ----------*/
+
+int BarResampler::addTarget(const int step_unit_, const int step_length_)
+{
+    targets.push_back(Target{ step_unit_, step_length_ > 0 ? step_length_ : 1, 0, false, ResampledBar(), {} });
+
+    return getNumTargets() - 1;
+}
+
+/*---------- PERIODS ----------*/
+
+std::int64_t BarResampler::periodOf(const Target& target, const DateTime& datetime_) const
+{
+    if( target.step_unit == WEEKS )
+        return floorDiv(floorDiv(datetime_.getEpochDay() + EPOCH_DAY_TO_MONDAY, 7), target.step_length);
+
+    if( target.step_unit == MONTHS )
+        return floorDiv(std::int64_t(datetime_.getYear()) * 12 + datetime_.getMonth() - 1, target.step_length);
+
+    return floorDiv(datetime_.getEpoch(), secondsPerUnit(target.step_unit) * target.step_length);
+}
+
+DateTime BarResampler::periodStart(const Target& target, const std::int64_t period) const
+{
+    if( target.step_unit == WEEKS )
+        return DateTime::fromEpoch((period * target.step_length * 7 - EPOCH_DAY_TO_MONDAY) * SECONDS_PER_DAY);
+
+    if( target.step_unit == MONTHS )
+    {
+        const std::int64_t month_index = period * target.step_length;
+        return DateTime(static_cast<int>(floorDiv(month_index, 12)), static_cast<int>(month_index - floorDiv(month_index, 12) * 12) + 1, 1);
+    }
+
+    return DateTime::fromEpoch(period * secondsPerUnit(target.step_unit) * target.step_length);
+}
+
+/*---------- UPDATING ----------*/
+
+void BarResampler::update(const EquitySnapshot& snap)
+{
+    // the snapshot as a one-snapshot trade bar: opens and closes at last, live ticks have no low / high (-1)
+    const Bar trade(snap.getLast(), snap.getLast(), snap.getLow(), snap.getHigh());
+
+    for( Target& target : targets )
+    {
+        const std::int64_t period = periodOf(target, snap.getDatetime());
+
+        if( target.open && period != target.period )
+        {
+            target.completed.push_back(target.current);
+            target.open = false;
+        }
+
+        if( !target.open )
+        {
+            target.current = ResampledBar();
+            target.current.start = periodStart(target, period);
+            target.period = period;
+            target.open = true;
+        }
+
+        target.current.trade.merge(trade);
+        target.current.bid.update(snap.getBid());
+        target.current.ask.update(snap.getAsk());
+        target.current.volume += snap.getVolume();
+    }
+}
+
+void BarResampler::run(const HistoricalEquityData& hist)
+{
+    for( int position = 0; position < hist.getSize(); position++ )
+        update(hist[hist.getIndexByTime(position)]);
+}
+
+void BarResampler::flush()
+{
+    for( Target& target : targets )
+    {
+        if( target.open )
+        {
+            target.completed.push_back(target.current);
+            target.open = false;
+        }
+    }
+}
+
+/*---------- GETTERS ----------*/
+
+std::vector<ResampledBar> BarResampler::takeBars(const int target)
+{
+    return std::exchange(targets[target].completed, std::vector<ResampledBar>());
+}
+
+HistoricalEquityData BarResampler::toHistoricalEquityData(const int target, const std::string& ticker_) const
+{
+    HistoricalEquityData hist(ticker_, targets[target].step_unit, targets[target].step_length);
+
+    hist.reserve(getBars(target).size());
+
+    for( const ResampledBar& bar : getBars(target) )
+    {
+        hist.append_exact(EquitySnapshot(bar.start, bar.trade.getLast(), bar.trade.getLow(), bar.trade.getHigh(),
+                                         bar.bid.getLast(), bar.ask.getLast(), static_cast<int>(bar.volume)));
+    }
+
+    return hist;
+}
+
+} // namespace
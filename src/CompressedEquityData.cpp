@@ -0,0 +1,258 @@
+/**
+ * @file    CompressedEquityData.cpp
+ * @brief   Defines the CompressedEquityData class functionality.
+ *
+ * This file contains the varint helpers and the per-column block encoder and
+ * decoder used by CompressedEquityData.
+ *
+ * @author  Benny Zaionz
+ * @date    2026-10-18
+ * @version 1.0
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include "CompressedEquityData.h"
+
+namespace AlgoTrading
+{
+
+namespace
+{
+
+/*---------- VARINTS ----------*/
+
+std::uint64_t zigzag(const std::int64_t v)
+{
+    return (static_cast<std::uint64_t>(v) << 1) ^ static_cast<std::uint64_t>(v >> 63);
+}
+
+std::int64_t unzigzag(const std::uint64_t v)
+{
+    return static_cast<std::int64_t>(v >> 1) ^ -static_cast<std::int64_t>(v & 1);
+}
+
+void putVarint(std::vector<std::uint8_t>& out, std::uint64_t v)
+{
+    while( v >= 0x80 )
+    {
+        out.push_back(static_cast<std::uint8_t>(v) | 0x80);
+        v >>= 7;
+    }
+
+    out.push_back(static_cast<std::uint8_t>(v));
+}
+
+std::uint64_t getVarint(const std::uint8_t*& p)
+{
+    std::uint64_t v = *p++;
+
+    if( v < 0x80 ) // most deltas fit in one byte
+        return v;
+
+    v &= 0x7F;
+
+    for( int shift = 7; ; shift += 7 )
+    {
+        std::uint64_t byte = *p++;
+        v |= (byte & 0x7F) << shift;
+
+        if( byte < 0x80 )
+            return v;
+    }
+}
+
+/*---------- COLUMN CODECS ----------*/
+
+// writes values[i] - base[i] as deltas from the previous row, base may be null
+void encodeDeltas(std::vector<std::uint8_t>& out, const std::int64_t* values, const std::int64_t* base, const int count)
+{
+    std::int64_t previous = 0;
+
+    for( int i = 0; i < count; i++ )
+    {
+        const std::int64_t current = values[i] - (base != nullptr ? base[i] : 0);
+        putVarint(out, zigzag(current - previous));
+        previous = current;
+    }
+}
+
+void decodeDeltas(const std::uint8_t*& p, std::int64_t* out, const std::int64_t* base, const int count)
+{
+    std::int64_t current = 0;
+
+    for( int i = 0; i < count; i++ )
+    {
+        current += unzigzag(getVarint(p));
+        out[i] = current + (base != nullptr ? base[i] : 0);
+    }
+}
+
+} // anonymous namespace
+
+/*---------- CONSTRUCTOR ----------*/
+
+CompressedEquityData::CompressedEquityData(const HistoricalEquityData& hist, const std::int64_t ticks_per_unit_):
+symbol(hist.getSymbol()), step_unit(hist.getStepUnit()), step_length(hist.getStepLength()),
+ticks_per_unit(ticks_per_unit_), bytes{}, blocks{}, num_rows(hist.getSize()), lossless(true)
+{
+    // rough guess of 8 bytes per row
+    bytes.reserve(static_cast<std::size_t>(num_rows) * 8);
+
+    for( int first = 0; first < num_rows; first += COMPRESSED_BLOCK_ROWS )
+        encodeBlock(hist, first, std::min(COMPRESSED_BLOCK_ROWS, num_rows - first));
+
+    bytes.shrink_to_fit();
+}
+
+/*---------- ENCODING ----------*/
+
+void CompressedEquityData::encodeBlock(const HistoricalEquityData& hist, const int first, const int count)
+{
+
+    /*
+    block layout, every field a zigzag varint:
+    - datetimes: first epoch, then delta of deltas (0 for evenly spaced bars)
+    - tick divisor: gcd of every price in ticks, so cent prices in 0.0001 ticks still give small deltas
+    - last: deltas from the previous row
+    - low, high, bid, ask: distance from the same row's last, delta coded
+    - volume: plain values
+    */
+
+    std::span<const DateTime> datetimes = hist.getDatetimeColumn().subspan(first, count);
+
+    blocks.push_back(BlockInfo{ bytes.size(), count, datetimes.front(), datetimes.back() });
+
+    std::int64_t previous = datetimes[0].getEpoch();
+    std::int64_t previous_delta = 0;
+
+    putVarint(bytes, zigzag(previous));
+
+    for( int i = 1; i < count; i++ )
+    {
+        const std::int64_t delta = datetimes[i].getEpoch() - previous;
+        putVarint(bytes, zigzag(delta - previous_delta));
+        previous = datetimes[i].getEpoch();
+        previous_delta = delta;
+    }
+
+    // prices in whole ticks
+    const double scale = static_cast<double>(ticks_per_unit);
+    const int price_types[5] = { LAST, LOW, HIGH, BID, ASK };
+
+    std::vector<std::int64_t> ticks[5];
+    std::int64_t divisor = 0;
+
+    for( int c = 0; c < 5; c++ )
+    {
+        std::span<const double> prices = hist.getPriceColumn(price_types[c]).subspan(first, count);
+
+        ticks[c].resize(count);
+
+        for( int i = 0; i < count; i++ )
+        {
+            ticks[c][i] = std::llround(prices[i] * scale);
+
+            if( static_cast<double>(ticks[c][i]) / scale != prices[i] )
+                lossless = false;
+
+            divisor = std::gcd(divisor, ticks[c][i]);
+        }
+    }
+
+    if( divisor == 0 )
+        divisor = 1;
+
+    putVarint(bytes, static_cast<std::uint64_t>(divisor));
+
+    for( int c = 0; c < 5; c++ )
+        for( std::int64_t& t : ticks[c] )
+            t /= divisor;
+
+    encodeDeltas(bytes, ticks[0].data(), nullptr, count);
+
+    for( int c = 1; c < 5; c++ )
+        encodeDeltas(bytes, ticks[c].data(), ticks[0].data(), count);
+
+    for( const int v : hist.getVolumeColumn().subspan(first, count) )
+        putVarint(bytes, zigzag(v));
+}
+
+/*---------- DECODING ----------*/
+
+void CompressedEquityData::decodeBlock(const int block, DecodedBlock& out) const
+{
+    const int count = blocks[block].num_rows;
+    const std::uint8_t* p = bytes.data() + blocks[block].offset;
+
+    out.datetimes.resize(count);
+    out.last.resize(count);
+    out.low.resize(count);
+    out.high.resize(count);
+    out.bid.resize(count);
+    out.ask.resize(count);
+    out.volume.resize(count);
+    out.last_ticks.resize(count);
+    out.ticks.resize(count);
+
+    std::int64_t current = unzigzag(getVarint(p));
+    std::int64_t delta = 0;
+
+    out.datetimes[0] = DateTime::fromEpoch(current);
+
+    for( int i = 1; i < count; i++ )
+    {
+        delta += unzigzag(getVarint(p));
+        current += delta;
+        out.datetimes[i] = DateTime::fromEpoch(current);
+    }
+
+    // dividing (rather than multiplying by the tick size) gives back the exact double for whole ticks,
+    // the varint loops stay integer-only and the divisions run in a separate loop the compiler can vectorize
+    const std::int64_t divisor = static_cast<std::int64_t>(getVarint(p));
+    const double scale = static_cast<double>(ticks_per_unit);
+
+    auto toPrices = [&](const std::int64_t* ticks, double* prices) {
+        for( int i = 0; i < count; i++ )
+            prices[i] = static_cast<double>(ticks[i] * divisor) / scale;
+    };
+
+    decodeDeltas(p, out.last_ticks.data(), nullptr, count);
+    toPrices(out.last_ticks.data(), out.last.data());
+
+    double* others[4] = { out.low.data(), out.high.data(), out.bid.data(), out.ask.data() };
+
+    for( int c = 0; c < 4; c++ )
+    {
+        decodeDeltas(p, out.ticks.data(), out.last_ticks.data(), count);
+        toPrices(out.ticks.data(), others[c]);
+    }
+
+    for( int i = 0; i < count; i++ )
+        out.volume[i] = static_cast<int>(unzigzag(getVarint(p)));
+}
+
+HistoricalEquityData CompressedEquityData::decompress() const
+{
+    HistoricalEquityData hist(symbol, step_unit, step_length);
+    DecodedBlock block;
+
+    hist.reserve(num_rows);
+
+    for( int b = 0; b < getNumBlocks(); b++ )
+    {
+        decodeBlock(b, block);
+        hist.append_columns(block.datetimes, block.last, block.low, block.high, block.bid, block.ask, block.volume);
+    }
+
+    return hist;
+}
+
+std::size_t CompressedEquityData::getRawBytes() const
+{
+    return static_cast<std::size_t>(num_rows) * (sizeof(DateTime) + 5 * sizeof(double) + sizeof(int));
+}
+
+} // namespace
@@ -0,0 +1,261 @@
+/**
+ * @file    CsvLoader.cpp
+ * @brief   Defines the CsvLoader class functionality.
+ *
+ * This file contains the chunking, the per-thread row parser (std::from_chars for
+ * numbers, DateTime::parse for timestamps) and the in-order merge into
+ * HistoricalEquityData, along with the printing helper for CsvLoadStats.
+ *
+ * @author  Benny Zaionz
+ * @date    2026-10-18
+ * @version 1.0
+ */
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <iostream>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "CsvLoader.h"
+#include "MappedFile.h"
+
+namespace AlgoTrading
+{
+
+namespace
+{
+
+const int CHUNKS_PER_THREAD = 4; // smaller chunks even out threads that get slower regions
+const std::size_t PAGE_SIZE = 4096;
+
+struct ParsedChunk
+{
+    std::vector<EquitySnapshot> rows;
+    std::vector<bool> date_only; // row had no "hh:mm:ss", its time is inferred on append
+    long long skipped = 0;
+};
+
+double secondsSince(const std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// parses [begin, end) as a number, an empty field leaves value unchanged
+template<typename T>
+bool parseField(const char* begin, const char* end, T& value)
+{
+    if( begin == end )
+        return true;
+
+    std::from_chars_result result = std::from_chars(begin, end, value);
+
+    return result.ec == std::errc() && result.ptr == end;
+}
+
+bool parseLine(const char* begin, const char* end, EquitySnapshot& out, bool& date_only)
+{
+
+    /*
+    "datetime,last,low,high,bid,ask,volume", missing trailing fields keep
+    the EquitySnapshot defaults (-1 prices, 0 volume)
+    */
+
+    const char* field_end = std::find(begin, end, ',');
+
+    DateTime datetime_;
+
+    if( !DateTime::parse(std::string_view(begin, field_end - begin), datetime_) )
+        return false;
+
+    date_only = (field_end - begin) == 8;
+
+    double prices[5] = { -1, -1, -1, -1, -1 }; // last, low, high, bid, ask
+    int volume_ = 0;
+
+    for( int field = 0; field < 6 && field_end != end; field++ )
+    {
+        begin = field_end + 1;
+        field_end = std::find(begin, end, ',');
+
+        bool ok = field < 5 ? parseField(begin, field_end, prices[field]) : parseField(begin, field_end, volume_);
+
+        if( !ok )
+            return false;
+    }
+
+    if( field_end != end ) // more than seven fields
+        return false;
+
+    out = EquitySnapshot(datetime_, prices[0], prices[1], prices[2], prices[3], prices[4], volume_);
+
+    return true;
+}
+
+void parseChunk(const char* begin, const char* end, ParsedChunk& chunk)
+{
+    // rough guess of ~50 bytes per row so most chunks never reallocate
+    chunk.rows.reserve((end - begin) / 50 + 1);
+
+    while( begin < end )
+    {
+        const char* line_end = std::find(begin, end, '\n');
+        const char* next = line_end == end ? end : line_end + 1;
+
+        if( line_end != begin && line_end[-1] == '\r' )
+            line_end--;
+
+        if( line_end != begin ) // skip blank lines
+        {
+            EquitySnapshot row;
+            bool date_only = false;
+
+            if( parseLine(begin, line_end, row, date_only) )
+            {
+                chunk.rows.push_back(row);
+                chunk.date_only.push_back(date_only);
+            }
+            else
+                chunk.skipped++;
+        }
+
+        begin = next;
+    }
+}
+
+// first position at or after pos that starts a line
+const char* alignToLine(const char* data, const char* pos, const char* end)
+{
+    if( pos == data || pos >= end )
+        return std::min(pos, end);
+
+    if( pos[-1] == '\n' )
+        return pos;
+
+    const char* newline = std::find(pos, end, '\n');
+
+    return newline == end ? end : newline + 1;
+}
+
+} // anonymous namespace
+
+/*---------- CONSTRUCTOR ----------*/
+
+CsvLoader::CsvLoader(const int num_threads_):
+num_threads(num_threads_) {}
+
+/*---------- LOADING ----------*/
+
+CsvLoadStats CsvLoader::load(const std::string& path, HistoricalEquityData& hist) const
+{
+    CsvLoadStats stats;
+
+    MappedFile file(path);
+
+    const char* data = file.data();
+    const char* end = data + file.size();
+
+    stats.bytes = file.size();
+    stats.threads = num_threads > 0 ? num_threads : std::max(1u, std::thread::hardware_concurrency());
+
+    // touch every page once so that read_seconds is the cost of getting the bytes into memory
+    auto start = std::chrono::steady_clock::now();
+
+    volatile char sink = 0;
+
+    for( std::size_t offset = 0; offset < file.size(); offset += PAGE_SIZE )
+        sink = sink + data[offset];
+
+    stats.read_seconds = secondsSince(start);
+
+    // header line, anything that does not start with a digit
+    if( data != end && (*data < '0' || *data > '9') )
+    {
+        const char* newline = std::find(data, end, '\n');
+        data = newline == end ? end : newline + 1;
+    }
+
+    // split into newline aligned chunks and parse them in parallel
+    start = std::chrono::steady_clock::now();
+
+    const std::size_t num_chunks = std::max<std::size_t>(1, std::min<std::size_t>(stats.threads * CHUNKS_PER_THREAD, (end - data) / PAGE_SIZE + 1));
+
+    std::vector<const char*> bounds(num_chunks + 1);
+
+    for( std::size_t c = 0; c <= num_chunks; c++ )
+        bounds[c] = alignToLine(data, data + (end - data) * c / num_chunks, end);
+
+    std::vector<ParsedChunk> chunks(num_chunks);
+    std::vector<std::thread> workers;
+
+    const int num_workers = static_cast<int>(std::min<std::size_t>(stats.threads, num_chunks));
+
+    for( int w = 0; w < num_workers; w++ )
+    {
+        workers.emplace_back([&, w]() {
+            for( std::size_t c = w; c < num_chunks; c += num_workers )
+                parseChunk(bounds[c], bounds[c + 1], chunks[c]);
+        });
+    }
+
+    for( std::thread& worker : workers )
+        worker.join();
+
+    stats.parse_seconds = secondsSince(start);
+
+    // merge in file order, rows with only a date get the usual intraday time inference
+    start = std::chrono::steady_clock::now();
+
+    std::size_t total_rows = 0;
+
+    for( const ParsedChunk& chunk : chunks )
+        total_rows += chunk.rows.size();
+
+    hist.reserve(hist.getSize() + static_cast<int>(total_rows));
+
+    for( ParsedChunk& chunk : chunks )
+    {
+        for( std::size_t i = 0; i < chunk.rows.size(); i++ )
+        {
+            if( chunk.date_only[i] )
+                hist.append_data(chunk.rows[i]);
+            else
+                hist.append_exact(chunk.rows[i]);
+        }
+
+        stats.rows += chunk.rows.size();
+        stats.rows_skipped += chunk.skipped;
+
+        std::vector<EquitySnapshot>().swap(chunk.rows); // release as we go
+        std::vector<bool>().swap(chunk.date_only);
+    }
+
+    stats.merge_seconds = secondsSince(start);
+
+    if( stats.rows_skipped > 0 )
+    {
+        std::cout << "---------- WARNING ----------" << std::endl
+                  << "Skipped " << stats.rows_skipped << " malformed rows in " << path << std::endl
+                  << "-----------------------------" << std::endl;
+    }
+
+    return stats;
+}
+
+/*---------- PRINT HELPER ----------*/
+
+void CsvLoadStats::print() const
+{
+    std::cout << "---------- CSV Load ----------" << std::endl
+              << "Rows: " << rows << ", Skipped: " << rows_skipped
+              << ", MB: " << bytes / 1e6 << ", Threads: " << threads << std::endl
+              << "Read: " << read_seconds << " s (" << readMbPerSec() << " MB/s)" << std::endl
+              << "Parse: " << parse_seconds << " s (" << parseMbPerSec() << " MB/s)" << std::endl
+              << "Merge: " << merge_seconds << " s" << std::endl
+              << "Total: " << rowsPerSec() << " rows/s, " << mbPerSec() << " MB/s" << std::endl
+              << "------------------------------" << std::endl;
+}
+
+} // namespace
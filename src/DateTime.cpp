@@ -2,9 +2,9 @@
  * @file    DateTime.cpp
  * @brief   Defines the DateTime class functionality.
  *
- * This file contains the functions defining the constructors for the 
- * DateTime class, as well as some useful functions including operator
- * overload for adding and subtracting dates.
+ * This file contains the string constructor for the DateTime class and
+ * its print helpers. The arithmetic and comparisons are constexpr integer
+ * operations defined inline in DateTime.h.
  *
  * @author  Benny Zaionz
  * @date    2025-06-19
@@ -15,125 +15,205 @@
  #include <iostream>
  #include <sstream>
  #include <iomanip>
+ #include <cstring>
+ #include <algorithm>
+
+ #if defined(__SSE4_1__)
+ #include <smmintrin.h>
+ #endif
 
  #include "DateTime.h"
 
  namespace AlgoTrading
  {
 
- DateTime::DateTime(const int year_,
-                    const int month_,
-                    const int day_,
-                    const int hour_,
-                    const int min_,
-                    const int sec_):
-    year(year_), month(month_), day(day_), hour(hour_), min(min_), sec(sec_) {}
+/*---------- PARSING HELPERS ----------*/
 
-DateTime::DateTime(const std::string& datetime_)
+namespace
+{
+
+bool isLeapYear(const int year_)
 {
+    return (year_ % 4 == 0 && year_ % 100 != 0) || year_ % 400 == 0;
+}
+
+bool validCivil(const int year_, const int month_, const int day_, const int hour_, const int min_, const int sec_)
+{
+    static const int days_in_month[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+
+    if( month_ < 1 || month_ > 12 || day_ < 1 )
+        return false;
+
+    const int max_day = days_in_month[month_ - 1] + (month_ == 2 && isLeapYear(year_));
+
+    return day_ <= max_day && hour_ < 24 && min_ < 60 && sec_ < 60;
+}
+
+bool parseDate8(const char* text, int& year_, int& month_, int& day_)
+{
+
     /*
-    if using the string version of the constructor, be careful
-    as it does not check for string formatting and validity
-    Assumes datetime_ is either "YYYYMMDD" or "YYYYMMDD hh:mm:ss"
+    converts the eight digits "YYYYMMDD" at once inside a 64 bit word
+    (SWAR), the first character lands in the low byte on little endian targets
     */
-    if( datetime_.size() == 8)
-    {
-        year  = std::stoi(datetime_.substr(0, 4));
-        month = std::stoi(datetime_.substr(4, 2));
-        day   = std::stoi(datetime_.substr(6, 2));
-        hour  = 0;
-        min   = 0;
-        sec   = 0;
-    }
 
-    else if( datetime_.size() == 17)
-    {
-        year  = std::stoi(datetime_.substr(0, 4));
-        month = std::stoi(datetime_.substr(4, 2));
-        day   = std::stoi(datetime_.substr(6, 2));
-        hour  = std::stoi(datetime_.substr(9, 10));
-        min   = std::stoi(datetime_.substr(12, 13));
-        sec   = std::stoi(datetime_.substr(15, 16));        
-    }
+    std::uint64_t v = 0;
+    std::memcpy(&v, text, 8);
 
-    else
-        throw::std::invalid_argument("Date string must be in YYYYMMDD format");
-}    
+    // every byte must be in ['0', '9']
+    if( ((v & 0xF0F0F0F0F0F0F0F0ULL) | (((v + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) != 0x3333333333333333ULL )
+        return false;
 
-DateTime DateTime::operator+(int secondsToAdd) const 
+    v -= 0x3030303030303030ULL;
+    v = (v * 10 + (v >> 8)) & 0x00FF00FF00FF00FFULL;        // pairs of digits
+    v = (v * 100 + (v >> 16)) & 0x0000FFFF0000FFFFULL;      // groups of four
+    v = (v * 10000 + (v >> 32)) & 0x00000000FFFFFFFFULL;    // all eight
+
+    const int yyyymmdd = static_cast<int>(v);
+
+    year_ = yyyymmdd / 10000;
+    month_ = yyyymmdd / 100 % 100;
+    day_ = yyyymmdd % 100;
+
+    return true;
+}
+
+bool parseTwoDigits(const char* text, int& value)
 {
-    
+    const unsigned tens = static_cast<unsigned char>(text[0]) - '0';
+    const unsigned ones = static_cast<unsigned char>(text[1]) - '0';
+
+    value = static_cast<int>(tens * 10 + ones);
+
+    return tens < 10 && ones < 10;
+}
+
+bool parseFields(std::string_view text, int& year_, int& month_, int& day_, int& hour_, int& min_, int& sec_)
+{
+    hour_ = min_ = sec_ = 0;
+
+    if( text.size() == 8 )
+        return parseDate8(text.data(), year_, month_, day_);
+
+    if( text.size() != 17 || text[8] != ' ' || text[11] != ':' || text[14] != ':' )
+        return false;
+
+    return parseDate8(text.data(), year_, month_, day_) &&
+           parseTwoDigits(text.data() + 9, hour_) &&
+           parseTwoDigits(text.data() + 12, min_) &&
+           parseTwoDigits(text.data() + 15, sec_);
+}
+
+#if defined(__SSE4_1__)
+
+bool parseFields17(const char* text, int& year_, int& month_, int& day_, int& hour_, int& min_, int& sec_)
+{
+
     /*
-    Since the twsapi only requires time data for time steps of
-    hr, min, and sec, this operator will only handle the logic for 
-    rolling over those values during market open time (i.e no
-    need to handle day rollover, month rollover, or year rollover)
+    "YYYYMMDD hh:mm:ss" in one 16 byte register: gather the 13 digits that
+    fit, insert the last one, check every lane is a digit, then combine
+    neighbouring digits with a single multiply-add
     */
 
-    int updated_sec = sec + secondsToAdd;
-    // handle hour rollover
-    int updated_hour = hour + updated_sec / 3600;
-    updated_sec = updated_sec % 3600;
+    if( text[8] != ' ' || text[11] != ':' || text[14] != ':' )
+        return false;
 
-    // handle minute rollover
-    int updated_min = min + updated_sec / 60;
-    updated_sec = updated_sec % 60;
+    const __m128i raw = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text));
+    const __m128i gather = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 9, 10, 12, 13, 15, -1, -1, -1);
 
-    return DateTime(year, month, day, updated_hour, updated_min, updated_sec);
-}
+    __m128i digits = _mm_shuffle_epi8(raw, gather);
+    digits = _mm_insert_epi8(digits, text[16], 13);
+    digits = _mm_sub_epi8(digits, _mm_setr_epi8('0', '0', '0', '0', '0', '0', '0', '0',
+                                                 '0', '0', '0', '0', '0', '0', 0, 0));
 
-DateTime& DateTime::operator+=(const int secondsToAdd) {
-    std::tm t = {};
-    t.tm_year = year - 1900;
-    t.tm_mon  = month - 1;
-    t.tm_mday = day;
-    t.tm_hour = hour;
-    t.tm_min  = min;
-    t.tm_sec  = sec + secondsToAdd;
-
-    std::time_t normalized = std::mktime(&t);
-    if (normalized == -1) {
-        throw std::runtime_error("Invalid time during += operation");
-    }
+    // unsigned digit <= 9 in every lane
+    const __m128i in_range = _mm_cmpeq_epi8(_mm_min_epu8(digits, _mm_set1_epi8(9)), digits);
+
+    if( _mm_movemask_epi8(in_range) != 0xFFFF )
+        return false;
 
-    // Update internal state
-    year  = t.tm_year + 1900;
-    month = t.tm_mon + 1;
-    day   = t.tm_mday;
-    hour  = t.tm_hour;
-    min   = t.tm_min;
-    sec   = t.tm_sec;
+    const __m128i pairs = _mm_maddubs_epi16(digits, _mm_setr_epi8(10, 1, 10, 1, 10, 1, 10, 1,
+                                                                  10, 1, 10, 1, 10, 1, 0, 0));
 
-    return *this;
+    year_ = _mm_extract_epi16(pairs, 0) * 100 + _mm_extract_epi16(pairs, 1);
+    month_ = _mm_extract_epi16(pairs, 2);
+    day_ = _mm_extract_epi16(pairs, 3);
+    hour_ = _mm_extract_epi16(pairs, 4);
+    min_ = _mm_extract_epi16(pairs, 5);
+    sec_ = _mm_extract_epi16(pairs, 6);
+
+    return true;
 }
 
-bool DateTime::operator==(const DateTime& datetime_)
+#endif
+
+} // anonymous namespace
+
+DateTime::DateTime(const std::string& datetime_)
 {
-    return ( getYear() == datetime_.getYear() &&
-             getMonth() == datetime_.getMonth() &&
-             getDay() == datetime_.getDay() &&
-             getHour() == datetime_.getHour() &&
-             getMin() == datetime_.getMin() &&
-             getSec() == datetime_.getSec() );
+    /*
+    Requires datetime_ to be either "YYYYMMDD" or "YYYYMMDD hh:mm:ss"
+    */
+    if( !parse(datetime_, *this) )
+        throw::std::invalid_argument("Date string must be a valid YYYYMMDD or YYYYMMDD hh:mm:ss, got: " + datetime_);
+}    
+
+/*---------- PARSING ----------*/
+
+bool DateTime::parse(std::string_view text, DateTime& out)
+{
+    int year_ = 0, month_ = 0, day_ = 0, hour_ = 0, min_ = 0, sec_ = 0;
+
+    if( !parseFields(text, year_, month_, day_, hour_, min_, sec_) || 
+        !validCivil(year_, month_, day_, hour_, min_, sec_) )
+        return false;
+
+    out = DateTime(year_, month_, day_, hour_, min_, sec_);
+
+    return true;
 }
 
-bool DateTime::sameDateAs(const DateTime& datetime_) const
+std::size_t DateTime::parseBatch(std::span<const std::string_view> texts, std::span<DateTime> out)
 {
-    return ( getYear() == datetime_.getYear() && 
-             getMonth() == datetime_.getMonth() &&
-             getDay() == datetime_.getDay() );
+    const std::size_t count = std::min(texts.size(), out.size());
+
+    for( std::size_t i = 0; i < count; i++ )
+    {
+        #if defined(__SSE4_1__)
+        if( texts[i].size() == 17 )
+        {
+            int year_, month_, day_, hour_, min_, sec_;
+
+            if( !parseFields17(texts[i].data(), year_, month_, day_, hour_, min_, sec_) || 
+                !validCivil(year_, month_, day_, hour_, min_, sec_) )
+                return i;
+
+            out[i] = DateTime(year_, month_, day_, hour_, min_, sec_);
+            continue;
+        }
+        #endif
+
+        if( !parse(texts[i], out[i]) )
+            return i;
+    }
+
+    return count;
 }
 
+
 std::string DateTime::toString() const
 {
+    int year = 0, month = 0, day = 0;
+    civilFromDays(getEpochDay(), year, month, day);
+
     std::stringstream ss;
 
     ss << std::setw(4) << std::setfill('0') << year << "-"
        << std::setw(2) << std::setfill('0') << month << "-"
        << std::setw(2) << std::setfill('0') << day << " "
-       << std::setw(2) << std::setfill('0') << hour << ":"
-       << std::setw(2) << std::setfill('0') << min << ":"
-       << std::setw(2) << std::setfill('0') << sec;
+       << std::setw(2) << std::setfill('0') << getHour() << ":"
+       << std::setw(2) << std::setfill('0') << getMin() << ":"
+       << std::setw(2) << std::setfill('0') << getSec();
 
     return ss.str();
 }
@@ -22,7 +22,8 @@ namespace AlgoTrading
 /*---------- CONSTRUCTOR ----------*/
 
 EquitySnapshot::EquitySnapshot():
-dt(DateTime()), last(-1), low(-1), high(-1), bid(-1), ask(-1), volume(0) {} 
+dt(DateTime()), last(Price::missing()), low(Price::missing()), high(Price::missing()),
+bid(Price::missing()), ask(Price::missing()), volume(0) {} 
 
 
 EquitySnapshot::EquitySnapshot(const std::string& datetime_,
@@ -32,7 +33,8 @@ EquitySnapshot::EquitySnapshot(const std::string& datetime_,
                                const double bid_,
                                const double ask_,
                                int volume_):
-dt(DateTime(datetime_)), last(last_), low(low_), high(high_), bid(bid_), ask(ask_), volume(volume_) {} 
+dt(DateTime(datetime_)), last(Price::fromPrice(last_)), low(Price::fromPrice(low_)), high(Price::fromPrice(high_)),
+bid(Price::fromPrice(bid_)), ask(Price::fromPrice(ask_)), volume(volume_) {} 
 
 EquitySnapshot::EquitySnapshot(const DateTime& datetime_,
                                const double last_,
@@ -41,7 +43,8 @@ EquitySnapshot::EquitySnapshot(const DateTime& datetime_,
                                const double bid_,
                                const double ask_,
                                int volume_):
-dt(datetime_), last(last_), low(low_), high(high_), bid(bid_), ask(ask_), volume(volume_) {} 
+dt(datetime_), last(Price::fromPrice(last_)), low(Price::fromPrice(low_)), high(Price::fromPrice(high_)),
+bid(Price::fromPrice(bid_)), ask(Price::fromPrice(ask_)), volume(volume_) {} 
 
 /*---------- GETTERS ----------*/
 
@@ -61,6 +64,22 @@ double EquitySnapshot::getPrice(const int price_type) const
     return -1;
 }
 
+Price EquitySnapshot::getFixedPrice(const int price_type) const
+{
+    if( price_type == LAST )
+        return last;
+    else if( price_type == LOW)
+        return low;
+    else if( price_type == HIGH )
+        return high;
+    else if( price_type == BID )
+        return bid;
+    else if( price_type == ASK )
+        return ask;
+
+    return Price::missing();
+}
+
 /*---------- PRINTING HELPERS ----------*/
 
 void EquitySnapshot::print(const int print_type) const
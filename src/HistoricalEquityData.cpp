@@ -1,6 +1,6 @@
 /*
 This files defines the HistoricalMarketData class which contains data about a stock over time
-It contains a vector of MarketSnapshots defined in Market_Snapshot.h
+It stores one contiguous Column per field of the EquitySnapshots appended to it
 */
 
 // #include <string>
@@ -10,10 +10,19 @@ It contains a vector of MarketSnapshots defined in Market_Snapshot.h
 // #include "Market_Snapshot.h"
 
 #include <algorithm>
+#include <bit>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
 #include <format>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
 
+#include "BarFile.h"
 #include "HistoricalEquityData.h"
+#include "MappedFile.h"
 
 namespace AlgoTrading
 {
@@ -23,54 +32,64 @@ namespace AlgoTrading
 HistoricalEquityData::HistoricalEquityData(const std::string& ticker_,
                                            const int step_unit_, 
                                            const int step_length_):
-ticker(ticker_), data{}, step_unit(step_unit_), step_length(step_length_) {}
+HistoricalEquityData(internSymbol(ticker_), step_unit_, step_length_) {}
+
+HistoricalEquityData::HistoricalEquityData(const SymbolId symbol_,
+                                           const int step_unit_, 
+                                           const int step_length_):
+symbol(symbol_), datetimes{}, last{}, low{}, high{}, bid{}, ask{}, volume{}, 
+step_unit(step_unit_), step_length(step_length_), time_index{}, date_counts{}, counted_rows(0) {}
 
 /*---------- GETTERS ----------*/
 
-std::vector<DateTime> HistoricalEquityData::getDatetimes() const
+std::vector<EquitySnapshot> HistoricalEquityData::getData() const
 {
+    std::vector<EquitySnapshot> snapshots = {};
 
-    std::vector<DateTime> datetimes = {};
-
-    std::vector<EquitySnapshot> snapshots = getData();
+    snapshots.reserve(getSize());
 
     for( int i = 0; i < getSize(); i++ )
     {
-        datetimes.push_back(snapshots[i].getDatetime());
+        snapshots.push_back(getRow(i).toSnapshot());
     }
 
-    return datetimes;
+    return snapshots;
 }
 
-std::vector<int> HistoricalEquityData::getHistoricalVolume() const
+std::vector<DateTime> HistoricalEquityData::getDatetimes() const
 {
-    std::vector<int> volumes = {};
+    std::span<const DateTime> column = getDatetimeColumn();
 
-    std::vector<EquitySnapshot> snapshots = getData();
+    return std::vector<DateTime>(column.begin(), column.end());
+}
 
-    for( int i = 0; i < getSize(); i++ )
-    {
-        volumes.push_back(snapshots[i].getVolume());
-    }
+std::vector<int> HistoricalEquityData::getHistoricalVolume() const
+{
+    std::span<const int> column = getVolumeColumn();
 
-    return volumes;
+    return std::vector<int>(column.begin(), column.end());
 }
 
-EquitySnapshot HistoricalEquityData::getSnapshotAt(std::string& datetime_) const
+EquitySnapshot HistoricalEquityData::getSnapshotAt(const std::string& datetime_) const
+{
+    return getSnapshotAt(DateTime(datetime_));
+}
+
+EquitySnapshot HistoricalEquityData::getSnapshotAt(const DateTime& datetime_) const
 {
 
     /*
     returns default EquitySnapshot if it is not found, use carefully
     */
-    int index = containsDatetime(datetime_);
+    int index = findDatetime(datetime_);
 
-    if( index != -1)
+    if( index != NOT_CONTAINED )
     {
-        return getData()[index];
+        return getRow(index).toSnapshot();
     }
 
     std::cout << "---------- WARNING ----------" << std::endl
-              << "Snapshot at: " << datetime_ 
+              << "Snapshot at: " << datetime_.toString()
               << " was not found in historical record of "
               << getTicker()
               << std::endl
@@ -82,27 +101,170 @@ EquitySnapshot HistoricalEquityData::getSnapshotAt(std::string& datetime_) const
 
 std::vector<double> HistoricalEquityData::getHistoricalPrices(const int price_type) const
 {
-    std::vector<double> prices = {};
+    std::span<const double> column = getPriceColumn(price_type);
 
-    std::vector<EquitySnapshot> snapshots = getData();
+    if( column.empty() ) // unknown price_type, same as EquitySnapshot::getPrice
+        return std::vector<double>(getSize(), -1);
 
-    for( int i = 0; i < getSize(); i++ )
+    return std::vector<double>(column.begin(), column.end());
+}
+
+/*---------- SAVING AND LOADING ----------*/
+
+static_assert(std::endian::native == std::endian::little, "bar files are little-endian");
+static_assert(sizeof(DateTime) == sizeof(std::int64_t) && std::is_trivially_copyable_v<DateTime>,
+              "the datetime block stores DateTime objects as raw int64 epochs");
+
+namespace
+{
+
+std::uint64_t alignOffset(const std::uint64_t offset)
+{
+    return (offset + BAR_FILE_ALIGNMENT - 1) / BAR_FILE_ALIGNMENT * BAR_FILE_ALIGNMENT;
+}
+
+template<typename T>
+void writeBlock(std::ofstream& out, std::span<const T> column, const std::uint64_t offset)
+{
+    static const char zeros[BAR_FILE_ALIGNMENT] = {};
+
+    out.write(zeros, offset - static_cast<std::uint64_t>(out.tellp()));
+    out.write(reinterpret_cast<const char*>(column.data()), column.size_bytes());
+}
+
+} // anonymous namespace
+
+void HistoricalEquityData::save(const std::string& path) const
+{
+    const std::string& ticker = getTicker();
+
+    if( ticker.size() > BAR_FILE_MAX_TICKER )
+        throw std::runtime_error("Ticker too long for bar file: " + ticker);
+
+    BarFileHeader header = {};
+
+    std::memcpy(header.magic, BAR_FILE_MAGIC, sizeof(header.magic));
+    std::memcpy(header.ticker, ticker.data(), ticker.size());
+    header.version = BAR_FILE_VERSION;
+    header.header_size = sizeof(BarFileHeader);
+    header.step_unit = step_unit;
+    header.step_length = step_length;
+    header.num_rows = getSize();
+    header.flags = isChronological() ? BAR_FILE_CHRONOLOGICAL : 0;
+
+    const std::uint64_t element_size[NUM_BAR_FILE_COLUMNS] = { sizeof(DateTime), sizeof(double), sizeof(double), sizeof(double),
+                                                               sizeof(double), sizeof(double), sizeof(int) };
+    std::uint64_t offset = sizeof(BarFileHeader);
+
+    for( int c = 0; c < NUM_BAR_FILE_COLUMNS; c++ )
+    {
+        header.column_offset[c] = alignOffset(offset);
+        offset = header.column_offset[c] + element_size[c] * header.num_rows;
+    }
+
+    /*
+    written next to path and renamed over it, so a crash never leaves path half written. On POSIX a
+    process that has path mapped through load() keeps reading the old file. Windows cannot replace
+    a file that is mapped, there the rename fails (std::runtime_error, path left as it was) until
+    every HistoricalEquityData loaded from path is gone
+    */
+    const std::string temp_path = path + ".tmp";
+
+    {
+        std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+
+        if( !out )
+            throw std::runtime_error("Could not open bar file for writing: " + temp_path);
+
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        writeBlock(out, getDatetimeColumn(), header.column_offset[COL_DATETIME]);
+        writeBlock(out, getPriceColumn(LAST), header.column_offset[COL_LAST]);
+        writeBlock(out, getPriceColumn(LOW), header.column_offset[COL_LOW]);
+        writeBlock(out, getPriceColumn(HIGH), header.column_offset[COL_HIGH]);
+        writeBlock(out, getPriceColumn(BID), header.column_offset[COL_BID]);
+        writeBlock(out, getPriceColumn(ASK), header.column_offset[COL_ASK]);
+        writeBlock(out, getVolumeColumn(), header.column_offset[COL_VOLUME]);
+
+        out.close();
+
+        if( !out )
+        {
+            std::error_code ignored;
+            std::filesystem::remove(temp_path, ignored);
+            throw std::runtime_error("Could not write bar file: " + temp_path);
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temp_path, path, error);
+
+    if( error )
+    {
+        std::error_code ignored;
+        std::filesystem::remove(temp_path, ignored);
+        throw std::runtime_error("Could not replace bar file: " + path + " (" + error.message() + ")");
+    }
+}
+
+HistoricalEquityData HistoricalEquityData::load(const std::string& path)
+{
+    std::shared_ptr<const MappedFile> file = std::make_shared<const MappedFile>(path);
+
+    if( file->size() < sizeof(BarFileHeader) )
+        throw std::runtime_error("Not a bar file (too small): " + path);
+
+    BarFileHeader header;
+    std::memcpy(&header, file->data(), sizeof(header));
+
+    if( std::memcmp(header.magic, BAR_FILE_MAGIC, sizeof(header.magic)) != 0 )
+        throw std::runtime_error("Not a bar file (bad magic): " + path);
+
+    if( header.version != BAR_FILE_VERSION || header.header_size != sizeof(BarFileHeader) )
+        throw std::runtime_error("Unsupported bar file version: " + path);
+
+    const std::uint64_t element_size[NUM_BAR_FILE_COLUMNS] = { sizeof(DateTime), sizeof(double), sizeof(double), sizeof(double),
+                                                               sizeof(double), sizeof(double), sizeof(int) };
+
+    for( int c = 0; c < NUM_BAR_FILE_COLUMNS; c++ )
     {
-        prices.push_back(snapshots[i].getPrice(price_type));
+        // the header is untrusted, compared by division so a huge num_rows cannot wrap past the check
+        if( header.column_offset[c] % BAR_FILE_ALIGNMENT != 0 ||
+            header.column_offset[c] > file->size() ||
+            header.num_rows > (file->size() - header.column_offset[c]) / element_size[c] )
+            throw std::runtime_error("Corrupt bar file (bad column block): " + path);
     }
 
-    return prices;
+    header.ticker[BAR_FILE_MAX_TICKER] = '\0';
+
+    HistoricalEquityData hist(header.ticker, header.step_unit, header.step_length);
+
+    const char* base = file->data();
+    const std::size_t n = header.num_rows;
+
+    hist.datetimes.borrow(reinterpret_cast<const DateTime*>(base + header.column_offset[COL_DATETIME]), n, file);
+    hist.last.borrow(reinterpret_cast<const double*>(base + header.column_offset[COL_LAST]), n, file);
+    hist.low.borrow(reinterpret_cast<const double*>(base + header.column_offset[COL_LOW]), n, file);
+    hist.high.borrow(reinterpret_cast<const double*>(base + header.column_offset[COL_HIGH]), n, file);
+    hist.bid.borrow(reinterpret_cast<const double*>(base + header.column_offset[COL_BID]), n, file);
+    hist.ask.borrow(reinterpret_cast<const double*>(base + header.column_offset[COL_ASK]), n, file);
+    hist.volume.borrow(reinterpret_cast<const int*>(base + header.column_offset[COL_VOLUME]), n, file);
+
+    // date counts are rebuilt lazily by the next append, the time index only for unsorted files
+    if( !(header.flags & BAR_FILE_CHRONOLOGICAL) )
+        hist.rebuildTimeIndex();
+
+    return hist;
 }
 
 /*---------- PRINTER HELPER ---------*/
 
 void HistoricalEquityData::print(const int print_type) const
 {
-    std::cout << "---------- " << ticker << " History ----------" << std::endl;
+    std::cout << "---------- " << getTicker() << " History ----------" << std::endl;
 
-    for ( int i = 0; i < data.size(); i++ )
+    for ( int i = 0; i < getSize(); i++ )
     {
-        data[i].print(print_type);
+        getRow(i).print(print_type);
     }
 
     std::cout << "----------------------------------" << std::endl;
@@ -117,16 +279,225 @@ int HistoricalEquityData::containsDatetime(const std::string& datetime_) const
     returns index of datetime if it exists in data, otherwise return NOT_CONTAINED
     */
 
-    std::vector<DateTime> datetimes = getDatetimes();
+    return findDatetime(DateTime(datetime_));
+}
+
+/*---------- TIMESTAMP LOOKUPS ----------*/
 
-    auto it = std::find(datetimes.begin(), datetimes.end(), datetime_);
+int HistoricalEquityData::findDatetime(const DateTime& datetime_) const
+{
+    int position = lowerPosition(datetime_);
+
+    if( position == getSize() )
+        return NOT_CONTAINED;
 
-    if( it != datetimes.end() )
-        return static_cast<int>(std::distance(datetimes.begin(), it));
+    int index = getIndexByTime(position);
+
+    if( datetimes[index] == datetime_ )
+        return index;
 
     return NOT_CONTAINED;
 }
 
+int HistoricalEquityData::findAsOf(const DateTime& datetime_) const
+{
+    int position = upperPosition(datetime_);
+
+    if( position == 0 ) // every bar is after datetime_
+        return NOT_CONTAINED;
+
+    return getIndexByTime(position - 1);
+}
+
+IndexRange HistoricalEquityData::findRange(const DateTime& start, const DateTime& end) const
+{
+    int begin = lowerPosition(start);
+
+    return IndexRange{ begin, std::max(begin, upperPosition(end)) };
+}
+
+int HistoricalEquityData::lowerPosition(const DateTime& datetime_) const
+{
+    int lo = 0;
+    int hi = getSize();
+
+    while( lo < hi )
+    {
+        int mid = lo + (hi - lo) / 2;
+
+        if( datetimes[getIndexByTime(mid)] < datetime_ )
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return lo;
+}
+
+int HistoricalEquityData::upperPosition(const DateTime& datetime_) const
+{
+    int lo = 0;
+    int hi = getSize();
+
+    while( lo < hi )
+    {
+        int mid = lo + (hi - lo) / 2;
+
+        if( datetime_ < datetimes[getIndexByTime(mid)] )
+            hi = mid;
+        else
+            lo = mid + 1;
+    }
+
+    return lo;
+}
+
+/*---------- RANGE VIEWS ----------*/
+
+HistoricalEquityView HistoricalEquityData::getView(const int begin, const int end) const
+{
+    const int clamped_begin = std::clamp(begin, 0, getSize());
+
+    return HistoricalEquityView(*this, clamped_begin, std::clamp(end, clamped_begin, getSize()));
+}
+
+HistoricalEquityView HistoricalEquityData::getRange(const DateTime& start, const DateTime& end) const
+{
+
+    /*
+    a time range is only contiguous in memory when rows were appended in
+    chronological order, otherwise an empty view is returned
+    */
+
+    if( !isChronological() )
+    {
+        std::cout << "---------- WARNING ----------" << std::endl
+                  << "Historical record of " << getTicker() 
+                  << " is not in chronological order, cannot take a time range view" << std::endl
+                  << "Returning empty view" << std::endl
+                  << "-----------------------------" << std::endl;
+
+        return HistoricalEquityView(*this, 0, 0);
+    }
+
+    IndexRange range = findRange(start, end);
+
+    return HistoricalEquityView(*this, range.begin, range.end);
+}
+
+/*---------- VIEW GETTERS ----------*/
+
+std::vector<EquitySnapshot> HistoricalEquityView::getData() const
+{
+    std::vector<EquitySnapshot> snapshots = {};
+
+    snapshots.reserve(getSize());
+
+    for( int i = 0; i < getSize(); i++ )
+        snapshots.push_back(getRow(i).toSnapshot());
+
+    return snapshots;
+}
+
+std::vector<DateTime> HistoricalEquityView::getDatetimes() const
+{
+    std::span<const DateTime> column = getDatetimeColumn();
+
+    return std::vector<DateTime>(column.begin(), column.end());
+}
+
+std::vector<double> HistoricalEquityView::getHistoricalPrices(const int price_type) const
+{
+    std::span<const double> column = getPriceColumn(price_type);
+
+    if( column.empty() ) // unknown price_type, same as EquitySnapshot::getPrice
+        return std::vector<double>(getSize(), -1);
+
+    return std::vector<double>(column.begin(), column.end());
+}
+
+std::vector<int> HistoricalEquityView::getHistoricalVolume() const
+{
+    std::span<const int> column = getVolumeColumn();
+
+    return std::vector<int>(column.begin(), column.end());
+}
+
+/*---------- VIEW SLICING ----------*/
+
+HistoricalEquityView HistoricalEquityView::getView(const int begin, const int end) const
+{
+    const int clamped_begin = std::clamp(begin, 0, getSize());
+
+    return HistoricalEquityView(*hist, first + clamped_begin, first + std::clamp(end, clamped_begin, getSize()));
+}
+
+HistoricalEquityView HistoricalEquityView::getRange(const DateTime& start, const DateTime& end) const
+{
+    if( !hist->isChronological() ) // same rule as HistoricalEquityData::getRange
+        return getView(0, 0);
+
+    std::span<const DateTime> datetimes_ = getDatetimeColumn();
+
+    const int begin = std::lower_bound(datetimes_.begin(), datetimes_.end(), start) - datetimes_.begin();
+    const int stop = std::upper_bound(datetimes_.begin(), datetimes_.end(), end) - datetimes_.begin();
+
+    return getView(begin, stop);
+}
+
+void HistoricalEquityView::print(const int print_type) const
+{
+    std::cout << "---------- " << getTicker() << " History ----------" << std::endl;
+
+    for ( int i = 0; i < getSize(); i++ )
+    {
+        getRow(i).print(print_type);
+    }
+
+    std::cout << "----------------------------------" << std::endl;
+}
+
+void HistoricalEquityData::rebuildTimeIndex()
+{
+    time_index.resize(getSize());
+
+    for( int i = 0; i < getSize(); i++ )
+        time_index[i] = i;
+
+    std::stable_sort(time_index.begin(), time_index.end(),
+                     [this](const int a, const int b) { return datetimes[a] < datetimes[b]; });
+
+    if( std::is_sorted(datetimes.data(), datetimes.data() + getSize()) )
+        time_index.clear();
+}
+
+void HistoricalEquityData::indexDatetime(const int index)
+{
+
+    /*
+    keeps the timestamp index current for the row just pushed at index,
+    in-order appends (the normal case for twsapi data) cost nothing, an
+    out-of-order append switches to an explicit sorted list of row indices
+    */
+
+    if( time_index.empty() )
+    {
+        if( index == 0 || !(datetimes[index] < datetimes[index - 1]) )
+            return;
+
+        time_index.resize(index);
+
+        for( int i = 0; i < index; i++ )
+            time_index[i] = i;
+    }
+
+    // upper bound keeps rows with equal datetimes in the order they were appended
+    auto it = std::upper_bound(time_index.begin(), time_index.end(), index,
+                               [this](const int a, const int b) { return datetimes[a] < datetimes[b]; });
+
+    time_index.insert(it, index);
+}
+
 int HistoricalEquityData::countDate(const DateTime& datetime_) const
 {
 
@@ -136,33 +507,69 @@ int HistoricalEquityData::countDate(const DateTime& datetime_) const
     granularity greater than 1 day (ex: 10 mins), since twsapi
     only gives the date "YYYYMMDD" and inference is required for the 
     time "HH:MM"
+
+    only counts the first counted_rows rows, call syncDateCounts() first,
+    rows from append_data count under the date they were given
     */
-    
-    // std::string date_ = datetime_.substr(0, 4);
 
-    std::vector<DateTime> hist_datetimes = getDatetimes();
+    auto it = date_counts.find(dateKey(datetime_));
 
-    int count = 0;
+    if( it == date_counts.end() )
+        return 0;
 
-    for( int i = 0; i < getSize(); i++ )
-    {
-        if( hist_datetimes[i].sameDateAs(datetime_) )
-            count++;
-    }
+    return it->second;
+}
 
-    return count;
+void HistoricalEquityData::syncDateCounts()
+{
+    for( ; counted_rows < getSize(); counted_rows++ )
+        date_counts[dateKey(datetimes[counted_rows])]++;
 }
 
 void HistoricalEquityData::append_data(const EquitySnapshot& eq)
 {
 
-    EquitySnapshot modified = eq;
+    syncDateCounts();
 
-    DateTime corrected_dt = datetimeHandler(modified.getDatetime());
+    EquitySnapshot corrected = eq;
+    corrected.setDatetime(datetimeHandler(eq.getDatetime()));
 
-    modified.setDatetime(corrected_dt);
+    append_exact(corrected);
 
-    data.push_back(std::move(modified));
+    /*
+    counted under the date it was given, not the inferred timestamp, which rolls into the next
+    day once a long intraday series passes midnight: counting it there would restart that
+    date's inference and repeat timestamps, this keeps them increasing from the given date
+    */
+    date_counts[dateKey(eq.getDatetime())]++;
+    counted_rows = getSize();
+}
+
+void HistoricalEquityData::append_exact(const EquitySnapshot& eq)
+{
+
+    /*
+    date counts are not touched here, syncDateCounts() picks these rows
+    up before the next inferred append
+    */
+
+    datetimes.push_back(eq.getDatetime());
+    last.push_back(eq.getLast());
+    low.push_back(eq.getLow());
+    high.push_back(eq.getHigh());
+    bid.push_back(eq.getBid());
+    ask.push_back(eq.getAsk());
+    volume.push_back(eq.getVolume());
+
+    indexDatetime(getSize() - 1);
+}
+
+void HistoricalEquityData::append_exact(std::span<const EquitySnapshot> snapshots)
+{
+    growFor(static_cast<int>(snapshots.size()));
+
+    for( const EquitySnapshot& eq : snapshots )
+        append_exact(eq);
 }
 
 void HistoricalEquityData::append_data(const LiveEquity& leq)
@@ -170,6 +577,57 @@ void HistoricalEquityData::append_data(const LiveEquity& leq)
     append_data(leq.getCurrentSnapshot());
 }
 
+void HistoricalEquityData::append_data(std::span<const EquitySnapshot> snapshots)
+{
+    append_data(snapshots.begin(), snapshots.end());
+}
+
+void HistoricalEquityData::append_columns(std::span<const DateTime> datetimes_,
+                                          std::span<const double> last_,
+                                          std::span<const double> low_,
+                                          std::span<const double> high_,
+                                          std::span<const double> bid_,
+                                          std::span<const double> ask_,
+                                          std::span<const int> volume_)
+{
+    const int first = getSize();
+
+    growFor(static_cast<int>(datetimes_.size()));
+
+    datetimes.append(datetimes_);
+    last.append(last_);
+    low.append(low_);
+    high.append(high_);
+    bid.append(bid_);
+    ask.append(ask_);
+    volume.append(volume_);
+
+    for( int i = first; i < getSize(); i++ )
+        indexDatetime(i);
+}
+
+void HistoricalEquityData::growFor(const int num_rows)
+{
+    const int needed = getSize() + num_rows;
+
+    if( needed <= static_cast<int>(datetimes.capacity()) )
+        return;
+
+    // at least double so that many small batches stay amortized O(1) per row
+    reserve(std::max(needed, 2*getSize()));
+}
+
+void HistoricalEquityData::reserve(const int num_rows)
+{
+    datetimes.reserve(num_rows);
+    last.reserve(num_rows);
+    low.reserve(num_rows);
+    high.reserve(num_rows);
+    bid.reserve(num_rows);
+    ask.reserve(num_rows);
+    volume.reserve(num_rows);
+}
+
 DateTime HistoricalEquityData::datetimeHandler(const DateTime& datetime_) const
 {
 
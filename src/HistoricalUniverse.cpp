@@ -0,0 +1,204 @@
+/**
+ * @file    HistoricalUniverse.cpp
+ * @brief   Defines the HistoricalUniverse class functionality.
+ *
+ * This file contains the construction of the master time axis, the merge of each
+ * ticker's history onto it, and the row, strided and transposed accessors.
+ *
+ * @author  Benny Zaionz
+ * @date    2026-10-18
+ * @version 1.0
+ */
+
+#include <algorithm>
+
+#include "HistoricalUniverse.h"
+
+namespace AlgoTrading
+{
+
+namespace
+{
+
+const int DOUBLES_PER_CACHE_LINE = COLUMN_ALIGNMENT / sizeof(double);
+const int TRANSPOSE_TILE = 32;
+
+} // anonymous namespace
+
+/*---------- CONSTRUCTOR ----------*/
+
+HistoricalUniverse::HistoricalUniverse(const std::vector<const HistoricalEquityData*>& histories):
+symbols{}, symbol_index{}, time_axis{}, stride(0)
+{
+    // symbols, a repeated ticker reuses its column
+    std::vector<int> column_of(histories.size());
+
+    for( std::size_t h = 0; h < histories.size(); h++ )
+    {
+        auto inserted = symbol_index.emplace(histories[h]->getSymbol(), static_cast<int>(symbols.size()));
+
+        if( inserted.second )
+            symbols.push_back(histories[h]->getSymbol());
+
+        column_of[h] = inserted.first->second;
+    }
+
+    // master time axis: sorted union of every history's datetimes
+    std::size_t total_rows = 0;
+
+    for( const HistoricalEquityData* hist : histories )
+        total_rows += hist->getSize();
+
+    time_axis.reserve(total_rows);
+
+    for( const HistoricalEquityData* hist : histories )
+    {
+        std::span<const DateTime> datetimes = hist->getDatetimeColumn();
+        time_axis.insert(time_axis.end(), datetimes.begin(), datetimes.end());
+    }
+
+    std::sort(time_axis.begin(), time_axis.end());
+    time_axis.erase(std::unique(time_axis.begin(), time_axis.end()), time_axis.end());
+    time_axis.shrink_to_fit();
+
+    // pad every row to whole cache lines
+    stride = (getNumSymbols() + DOUBLES_PER_CACHE_LINE - 1) / DOUBLES_PER_CACHE_LINE * DOUBLES_PER_CACHE_LINE;
+
+    const std::size_t cells = time_axis.size() * std::size_t(stride);
+
+    last.assign(cells, -1.0);
+    low.assign(cells, -1.0);
+    high.assign(cells, -1.0);
+    bid.assign(cells, -1.0);
+    ask.assign(cells, -1.0);
+    volume.assign(cells, 0);
+    valid.assign(cells, 0);
+
+    double* matrices[5] = { last.mutableData(), low.mutableData(), high.mutableData(), bid.mutableData(), ask.mutableData() };
+    int* volume_cells = volume.mutableData();
+    std::uint8_t* valid_cells = valid.mutableData();
+
+    // walk each history in time order alongside the axis
+    for( std::size_t h = 0; h < histories.size(); h++ )
+    {
+        const HistoricalEquityData& hist = *histories[h];
+        const int symbol = column_of[h];
+
+        std::span<const DateTime> datetimes = hist.getDatetimeColumn();
+        std::span<const double> prices[5] = { hist.getPriceColumn(LAST), hist.getPriceColumn(LOW), hist.getPriceColumn(HIGH),
+                                              hist.getPriceColumn(BID), hist.getPriceColumn(ASK) };
+        std::span<const int> volumes = hist.getVolumeColumn();
+
+        std::size_t t = 0;
+
+        for( int position = 0; position < hist.getSize(); position++ )
+        {
+            const int row = hist.getIndexByTime(position);
+
+            while( time_axis[t] < datetimes[row] )
+                t++;
+
+            const std::size_t cell = t * stride + symbol;
+
+            for( int c = 0; c < 5; c++ )
+                matrices[c][cell] = prices[c][row];
+
+            volume_cells[cell] = volumes[row];
+            valid_cells[cell] = 1;
+        }
+    }
+}
+
+/*---------- GETTERS ----------*/
+
+int HistoricalUniverse::getSymbolIndex(const SymbolId symbol_) const
+{
+    auto it = symbol_index.find(symbol_);
+
+    if( it == symbol_index.end() )
+        return NOT_CONTAINED;
+
+    return it->second;
+}
+
+int HistoricalUniverse::findTime(const DateTime& datetime_) const
+{
+    auto it = std::lower_bound(time_axis.begin(), time_axis.end(), datetime_);
+
+    if( it == time_axis.end() || *it != datetime_ )
+        return NOT_CONTAINED;
+
+    return static_cast<int>(it - time_axis.begin());
+}
+
+const Column<double>* HistoricalUniverse::priceMatrix(const int price_type) const
+{
+    if( price_type == LAST )
+        return &last;
+    else if( price_type == LOW )
+        return &low;
+    else if( price_type == HIGH )
+        return &high;
+    else if( price_type == BID )
+        return &bid;
+    else if( price_type == ASK )
+        return &ask;
+
+    return nullptr;
+}
+
+/*---------- CROSS SECTION ----------*/
+
+std::span<const double> HistoricalUniverse::getPriceRow(const int price_type, const int t) const
+{
+    const Column<double>* matrix = priceMatrix(price_type);
+
+    if( matrix == nullptr )
+        return {};
+
+    return matrix->view().subspan(std::size_t(t) * stride, getNumSymbols());
+}
+
+/*---------- HISTORY ----------*/
+
+StridedColumn<double> HistoricalUniverse::getPriceHistory(const int price_type, const int symbol) const
+{
+    const Column<double>* matrix = priceMatrix(price_type);
+
+    if( matrix == nullptr )
+        return { nullptr, 0, 0 };
+
+    return { matrix->data() + symbol, std::size_t(stride), time_axis.size() };
+}
+
+std::vector<double> HistoricalUniverse::getTransposedPrices(const int price_type) const
+{
+    const Column<double>* matrix = priceMatrix(price_type);
+
+    if( matrix == nullptr )
+        return {};
+
+    const std::size_t num_times = time_axis.size();
+    const std::size_t num_symbols = symbols.size();
+
+    std::vector<double> transposed(num_times * num_symbols);
+
+    // tiled so that both the reads and the writes stay within a few cache lines
+    for( std::size_t t0 = 0; t0 < num_times; t0 += TRANSPOSE_TILE )
+    {
+        const std::size_t t1 = std::min(num_times, t0 + TRANSPOSE_TILE);
+
+        for( std::size_t s0 = 0; s0 < num_symbols; s0 += TRANSPOSE_TILE )
+        {
+            const std::size_t s1 = std::min(num_symbols, s0 + TRANSPOSE_TILE);
+
+            for( std::size_t t = t0; t < t1; t++ )
+                for( std::size_t s = s0; s < s1; s++ )
+                    transposed[s * num_times + t] = (*matrix)[t * stride + s];
+        }
+    }
+
+    return transposed;
+}
+
+} // namespace
@@ -0,0 +1,692 @@
+/**
+ * @file    IndicatorKernels.cpp
+ * @brief   Defines the batch indicator kernels and their run time dispatch.
+ *
+ * This file contains the scalar, AVX2 and AVX-512 versions of every kernel. The
+ * recurrences (running sums, EMA) are computed a vector at a time as a prefix scan:
+ * the vector is scanned in registers with log2(width) shift-and-add steps, then the
+ * carry from the previous vector is added in, so the loop carried dependency is one
+ * add (or one FMA) per vector instead of one per row. Log returns use a vectorized
+ * log (exponent plus an atanh series on the mantissa), accurate to a few ulps.
+ *
+ * The SIMD versions are compiled with target attributes, so the file builds without
+ * -mavx2 / -mavx512f and the binary still runs on CPUs without them.
+ *
+ * @author  Benny Zaionz
+ * @date    2026-10-18
+ * @version 1.0
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include "IndicatorKernels.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ALGO_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace AlgoTrading
+{
+
+namespace
+{
+
+const double NOT_A_NUMBER = std::numeric_limits<double>::quiet_NaN();
+const int ZSCORE_BLOCK = 256; // rows whose mean and scale stay in L1 while every column is passed over
+
+/*---------- SCALAR ----------*/
+
+// the block kernels all SIMD versions implement, rows are independent of anything before the block but the carries
+
+// out[k] = carry + sum of add[j] - sub[j] for j <= k
+void sumDifferencesScalar(const double* add, const double* sub, const int count, const double carry, double* out)
+{
+    double sum = carry;
+
+    for( int k = 0; k < count; k++ )
+    {
+        sum += add[k] - sub[k];
+        out[k] = sum;
+    }
+}
+
+// the same running sums of x - center and (x - center)^2, written out as a population stddev
+void stdDevDifferencesScalar(const double* add, const double* sub, const int count, const double center,
+                             double sum, double sum_squares, const double inv_window, double* out)
+{
+    for( int k = 0; k < count; k++ )
+    {
+        const double entering = add[k] - center;
+        const double leaving = sub[k] - center;
+
+        sum += entering - leaving;
+        sum_squares += (entering - leaving) * (entering + leaving);
+
+        const double mean = sum * inv_window;
+        out[k] = std::sqrt(std::max(sum_squares * inv_window - mean * mean, 0.0));
+    }
+}
+
+void emaScalar(const double* prices, const int count, const double alpha, const double carry, double* out)
+{
+    double value = carry;
+
+    for( int k = 0; k < count; k++ )
+    {
+        value += alpha * (prices[k] - value);
+        out[k] = value;
+    }
+}
+
+// out[k] = log(prices[k + 1] / prices[k])
+void logRatiosScalar(const double* prices, const int count, double* out)
+{
+    for( int k = 0; k < count; k++ )
+        out[k] = prices[k] > 0 && prices[k + 1] > 0 ? std::log(prices[k + 1] / prices[k]) : NOT_A_NUMBER;
+}
+
+// rows [begin, begin + count), count <= ZSCORE_BLOCK, mean and scale are scratch
+void zScoreBlockScalar(const std::span<const double>* columns, const std::span<double>* outputs, const int num_columns,
+                       const int begin, const int count, double* mean, double* scale)
+{
+    std::fill(mean, mean + count, 0.0);
+    std::fill(scale, scale + count, 0.0);
+
+    for( int s = 0; s < num_columns; s++ )
+        for( int k = 0; k < count; k++ )
+            mean[k] += columns[s][begin + k];
+
+    for( int k = 0; k < count; k++ )
+        mean[k] /= num_columns;
+
+    for( int s = 0; s < num_columns; s++ )
+        for( int k = 0; k < count; k++ )
+            scale[k] += (columns[s][begin + k] - mean[k]) * (columns[s][begin + k] - mean[k]);
+
+    for( int k = 0; k < count; k++ )
+        scale[k] = scale[k] > 0 ? 1 / std::sqrt(scale[k] / num_columns) : 0;
+
+    for( int s = 0; s < num_columns; s++ )
+        for( int k = 0; k < count; k++ )
+            outputs[s][begin + k] = (columns[s][begin + k] - mean[k]) * scale[k];
+}
+
+#ifdef ALGO_SIMD_X86
+
+// log(m) = 2 atanh(s) = 2 (s + s^3 / 3 + s^5 / 5 + ...) with s = (m - 1) / (m + 1), |s| < 0.172 for m in [sqrt(1/2), sqrt(2)),
+// coefficients of the series in s^2 from the highest, truncated where the next term is below 1e-17
+const double LOG_SERIES[] = { 1.0 / 21, 1.0 / 19, 1.0 / 17, 1.0 / 15, 1.0 / 13, 1.0 / 11, 1.0 / 9, 1.0 / 7, 1.0 / 5, 1.0 / 3, 1.0 };
+const double SQRT_2 = 1.4142135623730951;
+const double LN_2_HI = 6.93147180369123816490e-01; // ln 2 split so that exponent * LN_2_HI is exact
+const double LN_2_LO = 1.90821492927058770002e-10;
+
+/*---------- AVX2 ----------*/
+
+__attribute__((target("avx2,fma"))) inline __m256d shiftUp1(const __m256d v)
+{
+    return _mm256_blend_pd(_mm256_permute4x64_pd(v, _MM_SHUFFLE(2, 1, 0, 0)), _mm256_setzero_pd(), 0x1);
+}
+
+__attribute__((target("avx2,fma"))) inline __m256d shiftUp2(const __m256d v)
+{
+    return _mm256_permute2f128_pd(v, v, 0x08);
+}
+
+__attribute__((target("avx2,fma"))) inline __m256d broadcastLast(const __m256d v)
+{
+    return _mm256_permute4x64_pd(v, _MM_SHUFFLE(3, 3, 3, 3));
+}
+
+__attribute__((target("avx2,fma"))) inline __m256d prefixSum(__m256d v)
+{
+    v = _mm256_add_pd(v, shiftUp1(v));
+    return _mm256_add_pd(v, shiftUp2(v));
+}
+
+__attribute__((target("avx2,fma")))
+void sumDifferencesAvx2(const double* add, const double* sub, const int count, const double carry, double* out)
+{
+    __m256d running = _mm256_set1_pd(carry);
+    int k = 0;
+
+    for( ; k + 4 <= count; k += 4 )
+    {
+        const __m256d v = prefixSum(_mm256_sub_pd(_mm256_loadu_pd(add + k), _mm256_loadu_pd(sub + k)));
+
+        _mm256_storeu_pd(out + k, _mm256_add_pd(running, v));
+        running = _mm256_add_pd(running, broadcastLast(v));
+    }
+
+    sumDifferencesScalar(add + k, sub + k, count - k, _mm256_cvtsd_f64(running), out + k);
+}
+
+__attribute__((target("avx2,fma")))
+void stdDevDifferencesAvx2(const double* add, const double* sub, const int count, const double center,
+                           const double sum, const double sum_squares, const double inv_window, double* out)
+{
+    const __m256d centers = _mm256_set1_pd(center);
+    const __m256d scale = _mm256_set1_pd(inv_window);
+    __m256d running = _mm256_set1_pd(sum);
+    __m256d running_squares = _mm256_set1_pd(sum_squares);
+    int k = 0;
+
+    for( ; k + 4 <= count; k += 4 )
+    {
+        const __m256d entering = _mm256_sub_pd(_mm256_loadu_pd(add + k), centers);
+        const __m256d leaving = _mm256_sub_pd(_mm256_loadu_pd(sub + k), centers);
+        const __m256d v = prefixSum(_mm256_sub_pd(entering, leaving));
+        const __m256d w = prefixSum(_mm256_mul_pd(_mm256_sub_pd(entering, leaving), _mm256_add_pd(entering, leaving)));
+
+        const __m256d mean = _mm256_mul_pd(_mm256_add_pd(running, v), scale);
+        const __m256d variance = _mm256_fmsub_pd(_mm256_add_pd(running_squares, w), scale, _mm256_mul_pd(mean, mean));
+
+        _mm256_storeu_pd(out + k, _mm256_sqrt_pd(_mm256_max_pd(variance, _mm256_setzero_pd())));
+        running = _mm256_add_pd(running, broadcastLast(v));
+        running_squares = _mm256_add_pd(running_squares, broadcastLast(w));
+    }
+
+    stdDevDifferencesScalar(add + k, sub + k, count - k, center, _mm256_cvtsd_f64(running),
+                            _mm256_cvtsd_f64(running_squares), inv_window, out + k);
+}
+
+__attribute__((target("avx2,fma")))
+void emaAvx2(const double* prices, const int count, const double alpha, const double carry, double* out)
+{
+    /*
+    y[k] = decay * y[k - 1] + alpha * x[k] scanned like a sum, each shift-and-add step
+    weighs the shifted lanes by the decay over the shift
+    */
+    const double decay = 1 - alpha;
+    const __m256d alphas = _mm256_set1_pd(alpha);
+    const __m256d decay_1 = _mm256_set1_pd(decay);
+    const __m256d decay_2 = _mm256_set1_pd(decay * decay);
+    const __m256d decay_4 = _mm256_set1_pd(decay * decay * decay * decay);
+    const __m256d decay_powers = _mm256_setr_pd(decay, decay * decay, decay * decay * decay, decay * decay * decay * decay);
+    __m256d running = _mm256_set1_pd(carry);
+    int k = 0;
+
+    for( ; k + 4 <= count; k += 4 )
+    {
+        __m256d v = _mm256_mul_pd(alphas, _mm256_loadu_pd(prices + k));
+        v = _mm256_fmadd_pd(decay_1, shiftUp1(v), v);
+        v = _mm256_fmadd_pd(decay_2, shiftUp2(v), v);
+
+        _mm256_storeu_pd(out + k, _mm256_fmadd_pd(decay_powers, running, v));
+        running = _mm256_fmadd_pd(decay_4, running, broadcastLast(v));
+    }
+
+    emaScalar(prices + k, count - k, alpha, _mm256_cvtsd_f64(running), out + k);
+}
+
+__attribute__((target("avx2,fma"))) inline __m256d logAvx2(const __m256d x)
+{
+    /*
+    x = 2^exponent * mantissa with the mantissa in [sqrt(1/2), sqrt(2)), only for positive normal x
+    */
+    const __m256i bits = _mm256_castpd_si256(x);
+    __m256i exponent = _mm256_sub_epi64(_mm256_srli_epi64(bits, 52), _mm256_set1_epi64x(1023));
+    __m256d mantissa = _mm256_castsi256_pd(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi64x(0x000FFFFFFFFFFFFFLL)),
+                                                           _mm256_set1_epi64x(0x3FF0000000000000LL)));
+
+    const __m256d above = _mm256_cmp_pd(mantissa, _mm256_set1_pd(SQRT_2), _CMP_GT_OQ);
+    mantissa = _mm256_blendv_pd(mantissa, _mm256_mul_pd(mantissa, _mm256_set1_pd(0.5)), above);
+    exponent = _mm256_sub_epi64(exponent, _mm256_castpd_si256(above)); // the mask is -1 where above
+
+    // small int64 to double: add into the mantissa of 1.5 * 2^52 and subtract it back
+    const __m256d magic = _mm256_set1_pd(6755399441055744.0);
+    const __m256d e = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_add_epi64(exponent, _mm256_castpd_si256(magic))), magic);
+
+    const __m256d one = _mm256_set1_pd(1);
+    const __m256d s = _mm256_div_pd(_mm256_sub_pd(mantissa, one), _mm256_add_pd(mantissa, one));
+    const __m256d z = _mm256_mul_pd(s, s);
+    __m256d series = _mm256_set1_pd(LOG_SERIES[0]);
+
+    for( int i = 1; i < static_cast<int>(std::size(LOG_SERIES)); i++ )
+        series = _mm256_fmadd_pd(series, z, _mm256_set1_pd(LOG_SERIES[i]));
+
+    const __m256d log_mantissa = _mm256_mul_pd(_mm256_add_pd(s, s), series);
+    return _mm256_fmadd_pd(e, _mm256_set1_pd(LN_2_HI), _mm256_fmadd_pd(e, _mm256_set1_pd(LN_2_LO), log_mantissa));
+}
+
+__attribute__((target("avx2,fma")))
+void logRatiosAvx2(const double* prices, const int count, double* out)
+{
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d nan = _mm256_set1_pd(NOT_A_NUMBER);
+    int k = 0;
+
+    for( ; k + 4 <= count; k += 4 )
+    {
+        const __m256d previous = _mm256_loadu_pd(prices + k);
+        const __m256d current = _mm256_loadu_pd(prices + k + 1);
+        const __m256d valid = _mm256_and_pd(_mm256_cmp_pd(previous, zero, _CMP_GT_OQ), _mm256_cmp_pd(current, zero, _CMP_GT_OQ));
+
+        _mm256_storeu_pd(out + k, _mm256_blendv_pd(nan, logAvx2(_mm256_div_pd(current, previous)), valid));
+    }
+
+    logRatiosScalar(prices + k, count - k, out + k);
+}
+
+// count is a multiple of 4
+__attribute__((target("avx2,fma")))
+void zScoreBlockAvx2(const std::span<const double>* columns, const std::span<double>* outputs, const int num_columns,
+                     const int begin, const int count, double* mean, double* scale)
+{
+    const __m256d inv_columns = _mm256_set1_pd(1.0 / num_columns);
+    const __m256d zero = _mm256_setzero_pd();
+
+    std::fill(mean, mean + count, 0.0);
+    std::fill(scale, scale + count, 0.0);
+
+    for( int s = 0; s < num_columns; s++ )
+        for( int k = 0; k < count; k += 4 )
+            _mm256_storeu_pd(mean + k, _mm256_add_pd(_mm256_loadu_pd(mean + k), _mm256_loadu_pd(&columns[s][begin + k])));
+
+    for( int k = 0; k < count; k += 4 )
+        _mm256_storeu_pd(mean + k, _mm256_mul_pd(_mm256_loadu_pd(mean + k), inv_columns));
+
+    for( int s = 0; s < num_columns; s++ )
+        for( int k = 0; k < count; k += 4 )
+        {
+            const __m256d deviation = _mm256_sub_pd(_mm256_loadu_pd(&columns[s][begin + k]), _mm256_loadu_pd(mean + k));
+            _mm256_storeu_pd(scale + k, _mm256_fmadd_pd(deviation, deviation, _mm256_loadu_pd(scale + k)));
+        }
+
+    for( int k = 0; k < count; k += 4 )
+    {
+        const __m256d stddev = _mm256_sqrt_pd(_mm256_mul_pd(_mm256_loadu_pd(scale + k), inv_columns));
+        const __m256d inverse = _mm256_div_pd(_mm256_set1_pd(1), stddev);
+        _mm256_storeu_pd(scale + k, _mm256_blendv_pd(zero, inverse, _mm256_cmp_pd(stddev, zero, _CMP_GT_OQ)));
+    }
+
+    for( int s = 0; s < num_columns; s++ )
+        for( int k = 0; k < count; k += 4 )
+        {
+            const __m256d deviation = _mm256_sub_pd(_mm256_loadu_pd(&columns[s][begin + k]), _mm256_loadu_pd(mean + k));
+            _mm256_storeu_pd(&outputs[s][begin + k], _mm256_mul_pd(deviation, _mm256_loadu_pd(scale + k)));
+        }
+}
+
+/*---------- AVX-512 ----------*/
+
+// GCC 12's avx512fintrin.h initializes its undefined vectors from themselves
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+__attribute__((target("avx512f"))) inline __m512d shiftUp(const __m512d v, const int lanes)
+{
+    // lanes is 1, 2 or 4, constant after inlining
+    const __m512i index = _mm512_sub_epi64(_mm512_set_epi64(7, 6, 5, 4, 3, 2, 1, 0), _mm512_set1_epi64(lanes));
+    return _mm512_maskz_permutexvar_pd(static_cast<__mmask8>(0xFF << lanes), index, v);
+}
+
+__attribute__((target("avx512f"))) inline __m512d broadcastLast(const __m512d v)
+{
+    return _mm512_permutexvar_pd(_mm512_set1_epi64(7), v);
+}
+
+__attribute__((target("avx512f"))) inline __m512d prefixSum(__m512d v)
+{
+    v = _mm512_add_pd(v, shiftUp(v, 1));
+    v = _mm512_add_pd(v, shiftUp(v, 2));
+    return _mm512_add_pd(v, shiftUp(v, 4));
+}
+
+__attribute__((target("avx512f")))
+void sumDifferencesAvx512(const double* add, const double* sub, const int count, const double carry, double* out)
+{
+    __m512d running = _mm512_set1_pd(carry);
+    int k = 0;
+
+    for( ; k + 8 <= count; k += 8 )
+    {
+        const __m512d v = prefixSum(_mm512_sub_pd(_mm512_loadu_pd(add + k), _mm512_loadu_pd(sub + k)));
+
+        _mm512_storeu_pd(out + k, _mm512_add_pd(running, v));
+        running = _mm512_add_pd(running, broadcastLast(v));
+    }
+
+    sumDifferencesScalar(add + k, sub + k, count - k, _mm512_cvtsd_f64(running), out + k);
+}
+
+__attribute__((target("avx512f")))
+void stdDevDifferencesAvx512(const double* add, const double* sub, const int count, const double center,
+                             const double sum, const double sum_squares, const double inv_window, double* out)
+{
+    const __m512d centers = _mm512_set1_pd(center);
+    const __m512d scale = _mm512_set1_pd(inv_window);
+    __m512d running = _mm512_set1_pd(sum);
+    __m512d running_squares = _mm512_set1_pd(sum_squares);
+    int k = 0;
+
+    for( ; k + 8 <= count; k += 8 )
+    {
+        const __m512d entering = _mm512_sub_pd(_mm512_loadu_pd(add + k), centers);
+        const __m512d leaving = _mm512_sub_pd(_mm512_loadu_pd(sub + k), centers);
+        const __m512d v = prefixSum(_mm512_sub_pd(entering, leaving));
+        const __m512d w = prefixSum(_mm512_mul_pd(_mm512_sub_pd(entering, leaving), _mm512_add_pd(entering, leaving)));
+
+        const __m512d mean = _mm512_mul_pd(_mm512_add_pd(running, v), scale);
+        const __m512d variance = _mm512_fmsub_pd(_mm512_add_pd(running_squares, w), scale, _mm512_mul_pd(mean, mean));
+
+        _mm512_storeu_pd(out + k, _mm512_sqrt_pd(_mm512_max_pd(variance, _mm512_setzero_pd())));
+        running = _mm512_add_pd(running, broadcastLast(v));
+        running_squares = _mm512_add_pd(running_squares, broadcastLast(w));
+    }
+
+    stdDevDifferencesScalar(add + k, sub + k, count - k, center, _mm512_cvtsd_f64(running),
+                            _mm512_cvtsd_f64(running_squares), inv_window, out + k);
+}
+
+__attribute__((target("avx512f")))
+void emaAvx512(const double* prices, const int count, const double alpha, const double carry, double* out)
+{
+    const double decay = 1 - alpha;
+    double powers[8];
+
+    powers[0] = decay;
+    for( int i = 1; i < 8; i++ )
+        powers[i] = powers[i - 1] * decay;
+
+    const __m512d alphas = _mm512_set1_pd(alpha);
+    const __m512d decay_1 = _mm512_set1_pd(powers[0]);
+    const __m512d decay_2 = _mm512_set1_pd(powers[1]);
+    const __m512d decay_4 = _mm512_set1_pd(powers[3]);
+    const __m512d decay_8 = _mm512_set1_pd(powers[7]);
+    const __m512d decay_powers = _mm512_loadu_pd(powers);
+    __m512d running = _mm512_set1_pd(carry);
+    int k = 0;
+
+    for( ; k + 8 <= count; k += 8 )
+    {
+        __m512d v = _mm512_mul_pd(alphas, _mm512_loadu_pd(prices + k));
+        v = _mm512_fmadd_pd(decay_1, shiftUp(v, 1), v);
+        v = _mm512_fmadd_pd(decay_2, shiftUp(v, 2), v);
+        v = _mm512_fmadd_pd(decay_4, shiftUp(v, 4), v);
+
+        _mm512_storeu_pd(out + k, _mm512_fmadd_pd(decay_powers, running, v));
+        running = _mm512_fmadd_pd(decay_8, running, broadcastLast(v));
+    }
+
+    emaScalar(prices + k, count - k, alpha, _mm512_cvtsd_f64(running), out + k);
+}
+
+__attribute__((target("avx512f"))) inline __m512d logAvx512(const __m512d x)
+{
+    // getexp / getmant split x into floor(log2 x) and a mantissa in [1, 2), then as logAvx2
+    __m512d e = _mm512_getexp_pd(x);
+    __m512d mantissa = _mm512_getmant_pd(x, _MM_MANT_NORM_1_2, _MM_MANT_SIGN_src);
+
+    const __mmask8 above = _mm512_cmp_pd_mask(mantissa, _mm512_set1_pd(SQRT_2), _CMP_GT_OQ);
+    mantissa = _mm512_mask_mul_pd(mantissa, above, mantissa, _mm512_set1_pd(0.5));
+    e = _mm512_mask_add_pd(e, above, e, _mm512_set1_pd(1));
+
+    const __m512d one = _mm512_set1_pd(1);
+    const __m512d s = _mm512_div_pd(_mm512_sub_pd(mantissa, one), _mm512_add_pd(mantissa, one));
+    const __m512d z = _mm512_mul_pd(s, s);
+    __m512d series = _mm512_set1_pd(LOG_SERIES[0]);
+
+    for( int i = 1; i < static_cast<int>(std::size(LOG_SERIES)); i++ )
+        series = _mm512_fmadd_pd(series, z, _mm512_set1_pd(LOG_SERIES[i]));
+
+    const __m512d log_mantissa = _mm512_mul_pd(_mm512_add_pd(s, s), series);
+    return _mm512_fmadd_pd(e, _mm512_set1_pd(LN_2_HI), _mm512_fmadd_pd(e, _mm512_set1_pd(LN_2_LO), log_mantissa));
+}
+
+__attribute__((target("avx512f")))
+void logRatiosAvx512(const double* prices, const int count, double* out)
+{
+    const __m512d zero = _mm512_setzero_pd();
+    int k = 0;
+
+    for( ; k + 8 <= count; k += 8 )
+    {
+        const __m512d previous = _mm512_loadu_pd(prices + k);
+        const __m512d current = _mm512_loadu_pd(prices + k + 1);
+        const __mmask8 valid = _mm512_cmp_pd_mask(previous, zero, _CMP_GT_OQ) & _mm512_cmp_pd_mask(current, zero, _CMP_GT_OQ);
+
+        _mm512_storeu_pd(out + k, _mm512_mask_mov_pd(_mm512_set1_pd(NOT_A_NUMBER), valid, logAvx512(_mm512_div_pd(current, previous))));
+    }
+
+    logRatiosScalar(prices + k, count - k, out + k);
+}
+
+// count is a multiple of 8
+__attribute__((target("avx512f")))
+void zScoreBlockAvx512(const std::span<const double>* columns, const std::span<double>* outputs, const int num_columns,
+                       const int begin, const int count, double* mean, double* scale)
+{
+    const __m512d inv_columns = _mm512_set1_pd(1.0 / num_columns);
+    const __m512d zero = _mm512_setzero_pd();
+
+    std::fill(mean, mean + count, 0.0);
+    std::fill(scale, scale + count, 0.0);
+
+    for( int s = 0; s < num_columns; s++ )
+        for( int k = 0; k < count; k += 8 )
+            _mm512_storeu_pd(mean + k, _mm512_add_pd(_mm512_loadu_pd(mean + k), _mm512_loadu_pd(&columns[s][begin + k])));
+
+    for( int k = 0; k < count; k += 8 )
+        _mm512_storeu_pd(mean + k, _mm512_mul_pd(_mm512_loadu_pd(mean + k), inv_columns));
+
+    for( int s = 0; s < num_columns; s++ )
+        for( int k = 0; k < count; k += 8 )
+        {
+            const __m512d deviation = _mm512_sub_pd(_mm512_loadu_pd(&columns[s][begin + k]), _mm512_loadu_pd(mean + k));
+            _mm512_storeu_pd(scale + k, _mm512_fmadd_pd(deviation, deviation, _mm512_loadu_pd(scale + k)));
+        }
+
+    for( int k = 0; k < count; k += 8 )
+    {
+        const __m512d stddev = _mm512_sqrt_pd(_mm512_mul_pd(_mm512_loadu_pd(scale + k), inv_columns));
+        const __mmask8 positive = _mm512_cmp_pd_mask(stddev, zero, _CMP_GT_OQ);
+        _mm512_storeu_pd(scale + k, _mm512_maskz_div_pd(positive, _mm512_set1_pd(1), stddev));
+    }
+
+    for( int s = 0; s < num_columns; s++ )
+        for( int k = 0; k < count; k += 8 )
+        {
+            const __m512d deviation = _mm512_sub_pd(_mm512_loadu_pd(&columns[s][begin + k]), _mm512_loadu_pd(mean + k));
+            _mm512_storeu_pd(&outputs[s][begin + k], _mm512_mul_pd(deviation, _mm512_loadu_pd(scale + k)));
+        }
+}
+
+#pragma GCC diagnostic pop
+
+#endif // ALGO_SIMD_X86
+
+/*---------- DISPATCH ----------*/
+
+struct KernelTable
+{
+    void (*sum_differences)(const double*, const double*, const int, const double, double*);
+    void (*std_dev_differences)(const double*, const double*, const int, const double, double, double, const double, double*);
+    void (*ema)(const double*, const int, const double, const double, double*);
+    void (*log_ratios)(const double*, const int, double*);
+    void (*z_score_block)(const std::span<const double>*, const std::span<double>*, const int, const int, const int, double*, double*);
+    int z_score_width; // z_score_block takes a multiple of this many rows
+};
+
+const KernelTable SCALAR_KERNELS = { sumDifferencesScalar, stdDevDifferencesScalar, emaScalar, logRatiosScalar, zScoreBlockScalar, 1 };
+
+#ifdef ALGO_SIMD_X86
+const KernelTable AVX2_KERNELS = { sumDifferencesAvx2, stdDevDifferencesAvx2, emaAvx2, logRatiosAvx2, zScoreBlockAvx2, 4 };
+const KernelTable AVX512_KERNELS = { sumDifferencesAvx512, stdDevDifferencesAvx512, emaAvx512, logRatiosAvx512, zScoreBlockAvx512, 8 };
+#endif
+
+int simd_level = detectSimdLevel();
+
+const KernelTable& kernels()
+{
+#ifdef ALGO_SIMD_X86
+    if( simd_level == SIMD_AVX512 )
+        return AVX512_KERNELS;
+    else if( simd_level == SIMD_AVX2 )
+        return AVX2_KERNELS;
+#endif
+
+    return SCALAR_KERNELS;
+}
+
+/*---------- CHECKS ----------*/
+
+void checkOutput(std::span<const double> prices, std::span<double> out)
+{
+    if( out.size() < prices.size() )
+        throw std::invalid_argument("Kernel output must be at least as long as its input");
+}
+
+void checkWindow(const int window)
+{
+    if( window < 1 )
+        throw std::invalid_argument("Kernel window must be at least 1, got: " + std::to_string(window));
+}
+
+} // namespace
+
+/*---------- DISPATCH ----------*/
+
+int detectSimdLevel()
+{
+#ifdef ALGO_SIMD_X86
+    __builtin_cpu_init();
+
+    if( __builtin_cpu_supports("avx512f") )
+        return SIMD_AVX512;
+    else if( __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") )
+        return SIMD_AVX2;
+#endif
+
+    return SIMD_SCALAR;
+}
+
+int getSimdLevel()
+{
+    return simd_level;
+}
+
+void setSimdLevel(const int level)
+{
+    simd_level = std::clamp(level, static_cast<int>(SIMD_SCALAR), detectSimdLevel());
+}
+
+/*---------- KERNELS ----------*/
+
+void rollingSum(std::span<const double> prices, const int window, std::span<double> out)
+{
+    checkOutput(prices, out);
+    checkWindow(window);
+
+    const int n = prices.size();
+    const int interval = std::max(ANCHOR_INTERVAL, window);
+    const KernelTable& table = kernels();
+
+    std::fill(out.begin(), out.begin() + std::min(window - 1, n), NOT_A_NUMBER);
+
+    for( int first = window - 1; first < n; first += interval )
+    {
+        /* every interval rows the sum restarts from the window itself */
+        const int end = std::min(first + interval, n);
+        double sum = 0;
+
+        for( int i = first - window + 1; i <= first; i++ )
+            sum += prices[i];
+
+        out[first] = sum;
+
+        // pointers rather than spans, the segment may start at the last row where [first + 1] is past the end
+        table.sum_differences(prices.data() + first + 1, prices.data() + first + 1 - window, end - first - 1, sum, out.data() + first + 1);
+    }
+}
+
+void rollingStdDev(std::span<const double> prices, const int window, std::span<double> out)
+{
+    checkOutput(prices, out);
+    checkWindow(window);
+
+    const int n = prices.size();
+    const int interval = std::max(ANCHOR_INTERVAL, window);
+    const double inv_window = 1.0 / window;
+    const KernelTable& table = kernels();
+
+    std::fill(out.begin(), out.begin() + std::min(window - 1, n), NOT_A_NUMBER);
+
+    for( int first = window - 1; first < n; first += interval )
+    {
+        /* sums of deviations from a price of the window keep E[x^2] - E[x]^2 from cancelling */
+        const int end = std::min(first + interval, n);
+        const double center = prices[first];
+        double sum = 0;
+        double sum_squares = 0;
+
+        for( int i = first - window + 1; i <= first; i++ )
+        {
+            sum += prices[i] - center;
+            sum_squares += (prices[i] - center) * (prices[i] - center);
+        }
+
+        const double mean = sum * inv_window;
+        out[first] = std::sqrt(std::max(sum_squares * inv_window - mean * mean, 0.0));
+
+        table.std_dev_differences(prices.data() + first + 1, prices.data() + first + 1 - window, end - first - 1,
+                                  center, sum, sum_squares, inv_window, out.data() + first + 1);
+    }
+}
+
+void exponentialMovingAverage(std::span<const double> prices, const int period, std::span<double> out)
+{
+    checkOutput(prices, out);
+    checkWindow(period);
+
+    if( prices.empty() )
+        return;
+
+    out[0] = prices[0];
+    kernels().ema(prices.data() + 1, prices.size() - 1, 2.0 / (period + 1), prices[0], out.data() + 1);
+}
+
+void logReturns(std::span<const double> prices, std::span<double> out)
+{
+    checkOutput(prices, out);
+
+    if( prices.empty() )
+        return;
+
+    out[0] = NOT_A_NUMBER;
+    kernels().log_ratios(prices.data(), prices.size() - 1, out.data() + 1);
+}
+
+void crossSectionalZScores(std::span<const std::span<const double>> columns, std::span<const std::span<double>> outputs)
+{
+    if( outputs.size() != columns.size() )
+        throw std::invalid_argument("crossSectionalZScores needs one output per column");
+
+    if( columns.empty() )
+        return;
+
+    const int n = columns[0].size();
+
+    for( int s = 0; s < static_cast<int>(columns.size()); s++ )
+        if( static_cast<int>(columns[s].size()) != n || static_cast<int>(outputs[s].size()) != n )
+            throw std::invalid_argument("crossSectionalZScores needs columns and outputs of the same length");
+
+    const KernelTable& table = kernels();
+    const int num_columns = columns.size();
+    const int vector_rows = n - n % table.z_score_width;
+    double mean[ZSCORE_BLOCK];
+    double scale[ZSCORE_BLOCK];
+
+    for( int begin = 0; begin < vector_rows; begin += ZSCORE_BLOCK )
+        table.z_score_block(columns.data(), outputs.data(), num_columns, begin, std::min(ZSCORE_BLOCK, vector_rows - begin), mean, scale);
+
+    if( vector_rows < n )
+        zScoreBlockScalar(columns.data(), outputs.data(), num_columns, vector_rows, n - vector_rows, mean, scale);
+}
+
+} // namespace
@@ -4,7 +4,10 @@ namespace AlgoTrading
 {
 
 LiveEquity::LiveEquity(const std::string& ticker_, const EquitySnapshot& snap):
-ticker(ticker_), currentSnapshot(snap) {}
+symbol(internSymbol(ticker_)), currentSnapshot(snap) {}
+
+LiveEquity::LiveEquity(const SymbolId symbol_, const EquitySnapshot& snap):
+symbol(symbol_), currentSnapshot(snap) {}
 
 void LiveEquity::print(int print_type) const
 {
@@ -0,0 +1,123 @@
+/**
+ * @file    MappedFile.cpp
+ * @brief   Defines the MappedFile class functionality.
+ *
+ * This file contains the platform specific code that maps and unmaps a file,
+ * CreateFileMapping/MapViewOfFile on Windows and mmap everywhere else.
+ *
+ * @author  Benny Zaionz
+ * @date    2026-10-18
+ * @version 1.0
+ */
+
+#include <stdexcept>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include "MappedFile.h"
+
+namespace AlgoTrading
+{
+
+/*---------- CONSTRUCTOR ----------*/
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string& path):
+mapped(nullptr), length(0), file_handle(INVALID_HANDLE_VALUE), mapping_handle(nullptr)
+{
+    file_handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+    if( file_handle == INVALID_HANDLE_VALUE )
+        throw std::runtime_error("Could not open file: " + path);
+
+    LARGE_INTEGER file_size;
+
+    if( !GetFileSizeEx(file_handle, &file_size) )
+    {
+        CloseHandle(file_handle);
+        throw std::runtime_error("Could not read size of file: " + path);
+    }
+
+    length = static_cast<std::size_t>(file_size.QuadPart);
+
+    if( length == 0 ) // an empty file cannot be mapped
+        return;
+
+    mapping_handle = CreateFileMappingA(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+    if( mapping_handle != nullptr )
+        mapped = static_cast<const char*>(MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0));
+
+    if( mapped == nullptr )
+    {
+        if( mapping_handle != nullptr )
+            CloseHandle(mapping_handle);
+        CloseHandle(file_handle);
+        throw std::runtime_error("Could not map file: " + path);
+    }
+}
+
+MappedFile::~MappedFile()
+{
+    if( mapped != nullptr )
+        UnmapViewOfFile(mapped);
+    if( mapping_handle != nullptr )
+        CloseHandle(mapping_handle);
+    if( file_handle != INVALID_HANDLE_VALUE )
+        CloseHandle(file_handle);
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& path):
+mapped(nullptr), length(0)
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+
+    if( fd < 0 )
+        throw std::runtime_error("Could not open file: " + path);
+
+    struct stat info;
+
+    if( ::fstat(fd, &info) != 0 )
+    {
+        ::close(fd);
+        throw std::runtime_error("Could not read size of file: " + path);
+    }
+
+    length = static_cast<std::size_t>(info.st_size);
+
+    if( length > 0 ) // an empty file cannot be mapped
+    {
+        void* region = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+
+        if( region == MAP_FAILED )
+        {
+            ::close(fd);
+            throw std::runtime_error("Could not map file: " + path);
+        }
+
+        mapped = static_cast<const char*>(region);
+    }
+
+    ::close(fd); // the mapping keeps its own reference to the file
+}
+
+MappedFile::~MappedFile()
+{
+    if( mapped != nullptr )
+        ::munmap(const_cast<char*>(mapped), length);
+}
+
+#endif
+
+} // namespace
@@ -0,0 +1,139 @@
+/**
+ * @file    PortfolioState.cpp
+ * @brief   Defines the PortfolioStateBuffer class functionality.
+ *
+ * This file contains the seqlock writer and reader of PortfolioStateBuffer. Every shared
+ * field is an atomic accessed with relaxed ordering, the ordering comes from the release
+ * and acquire operations on the sequence number and the fences around the data.
+ *
+ * @author  Benny Zaionz
+ * @date    2026-10-18
+ * @version 1.0
+ */
+
+#include <algorithm>
+#include <thread>
+
+#include "PortfolioState.h"
+
+namespace AlgoTrading
+{
+
+namespace
+{
+
+const std::size_t INITIAL_STATE_SLOTS = 64;
+
+} // anonymous namespace
+
+/*---------- CONSTRUCTOR ----------*/
+
+PortfolioStateBuffer::PortfolioStateBuffer():
+sequence(0), cash(0), market_value(0), unrealized_pnl(0), num_positions(0), current(nullptr), blocks{}
+{
+    blocks.push_back(std::make_unique<Block>(INITIAL_STATE_SLOTS));
+    current.store(blocks.back().get(), std::memory_order_release);
+}
+
+/*---------- WRITER ----------*/
+
+void PortfolioStateBuffer::beginWrite()
+{
+    sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release); // the odd sequence is visible before any data store
+}
+
+void PortfolioStateBuffer::endWrite()
+{
+    sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+void PortfolioStateBuffer::writeTotals(const Money cash_, const Money market_value_, const Money unrealized_pnl_)
+{
+    cash.store(cash_.getTicks(), std::memory_order_relaxed);
+    market_value.store(market_value_.getTicks(), std::memory_order_relaxed);
+    unrealized_pnl.store(unrealized_pnl_.getTicks(), std::memory_order_relaxed);
+}
+
+void PortfolioStateBuffer::writePosition(const int index, const PositionState& position)
+{
+    Block* block = blocks.back().get();
+
+    if( std::size_t(index) >= block->capacity )
+    {
+        /*
+        publish a copy twice the size, the old block stays allocated because a
+        reader may still be copying it, its sequence check will fail and it retries
+        */
+        blocks.push_back(std::make_unique<Block>(block->capacity * 2));
+        Block* grown = blocks.back().get();
+
+        for( int i = 0; i < num_positions.load(std::memory_order_relaxed); i++ )
+        {
+            grown->slots[i].symbol.store(block->slots[i].symbol.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            grown->slots[i].shares.store(block->slots[i].shares.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            grown->slots[i].cost_basis.store(block->slots[i].cost_basis.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            grown->slots[i].last.store(block->slots[i].last.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+
+        current.store(grown, std::memory_order_release);
+        block = grown;
+    }
+
+    Slot& slot = block->slots[index];
+
+    slot.symbol.store(position.symbol, std::memory_order_relaxed);
+    slot.shares.store(position.shares, std::memory_order_relaxed);
+    slot.cost_basis.store(position.cost_basis.getTicks(), std::memory_order_relaxed);
+    slot.last.store(position.last.getTicks(), std::memory_order_relaxed);
+
+    if( index >= num_positions.load(std::memory_order_relaxed) )
+        num_positions.store(index + 1, std::memory_order_relaxed);
+}
+
+/*---------- READERS ----------*/
+
+bool PortfolioStateBuffer::tryRead(PortfolioState& out) const
+{
+    const std::uint64_t before = sequence.load(std::memory_order_acquire);
+
+    if( before & 1 ) // writer in progress
+        return false;
+
+    const Block* block = current.load(std::memory_order_acquire);
+    const std::size_t count = std::min<std::size_t>(num_positions.load(std::memory_order_relaxed), block->capacity);
+
+    out.positions.resize(count);
+
+    for( std::size_t i = 0; i < count; i++ )
+    {
+        out.positions[i].symbol = block->slots[i].symbol.load(std::memory_order_relaxed);
+        out.positions[i].shares = block->slots[i].shares.load(std::memory_order_relaxed);
+        out.positions[i].cost_basis = Money::fromTicks(block->slots[i].cost_basis.load(std::memory_order_relaxed));
+        out.positions[i].last = Price::fromTicks(block->slots[i].last.load(std::memory_order_relaxed));
+    }
+
+    out.version = before / 2;
+    out.cash = Money::fromTicks(cash.load(std::memory_order_relaxed));
+    out.market_value = Money::fromTicks(market_value.load(std::memory_order_relaxed));
+    out.unrealized_pnl = Money::fromTicks(unrealized_pnl.load(std::memory_order_relaxed));
+
+    std::atomic_thread_fence(std::memory_order_acquire); // every data load happens before the second sequence load
+
+    return sequence.load(std::memory_order_relaxed) == before;
+}
+
+void PortfolioStateBuffer::read(PortfolioState& out) const
+{
+    while( !tryRead(out) )
+        std::this_thread::yield();
+}
+
+PortfolioState PortfolioStateBuffer::read() const
+{
+    PortfolioState out = {};
+    read(out);
+    return out;
+}
+
+} // namespace
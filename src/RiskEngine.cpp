@@ -0,0 +1,170 @@
+/**
+ * @file    RiskEngine.cpp
+ * @brief   Defines the RiskEngine class functionality.
+ *
+ * This file contains the limit setters, the incremental exposure updates and
+ * the pre-trade check of the RiskEngine class. The Portfolio facing templates
+ * (submit, syncPositions) are defined in RiskEngine.h.
+ *
+ * @author  Benny Zaionz
+ * @date    2026-10-18
+ * @version 1.0
+ */
+
+#include "RiskEngine.h"
+
+namespace AlgoTrading
+{
+
+namespace
+{
+
+Money absolute(const Money value)
+{
+    return value < Money() ? -value : value;
+}
+
+std::int64_t absolute(const std::int64_t value)
+{
+    return value < 0 ? -value : value;
+}
+
+} // anonymous namespace
+
+/*---------- CONSTRUCTOR ----------*/
+
+RiskEngine::RiskEngine(const RiskLimits& limits_): limits(limits_), symbols{}, gross_notional(), net_notional() {}
+
+/*---------- LIMITS ----------*/
+
+void RiskEngine::setLimits(const RiskLimits& limits_)
+{
+    limits = limits_;
+}
+
+void RiskEngine::setSymbolLimits(const SymbolId symbol_, const int max_order_shares_, const std::int64_t max_position_shares_)
+{
+    SymbolRisk& risk = getSymbol(symbol_);
+
+    risk.max_order_shares = max_order_shares_;
+    risk.max_position_shares = max_position_shares_;
+}
+
+RiskEngine::SymbolRisk& RiskEngine::getSymbol(const SymbolId symbol_)
+{
+    if( symbol_ >= symbols.size() )
+        symbols.resize(static_cast<std::size_t>(symbol_) + 1,
+                       SymbolRisk{ -1, -1, 0, Price::missing(), Price::missing(), Price::missing(), Money() });
+
+    return symbols[symbol_];
+}
+
+/*---------- MARKET DATA AND FILLS ----------*/
+
+void RiskEngine::setNotional(SymbolRisk& risk, const Money notional_)
+{
+    /*
+    swaps this symbol's contribution to the running sums, so a price tick
+    or a fill costs O(1) no matter how many symbols are held
+    */
+
+    gross_notional += absolute(notional_) - absolute(risk.notional);
+    net_notional += notional_ - risk.notional;
+    risk.notional = notional_;
+}
+
+void RiskEngine::updateMarket(const SymbolId symbol_, const Price bid_, const Price ask_, const Price last_)
+{
+    SymbolRisk& risk = getSymbol(symbol_);
+
+    risk.bid = bid_;
+    risk.ask = ask_;
+
+    if( !last_.isMissing() )
+        risk.mark = last_;
+    else if( !bid_.isMissing() && !ask_.isMissing() )
+        risk.mark = Price::fromTicks((bid_.getTicks() + ask_.getTicks()) / 2);
+
+    if( !risk.mark.isMissing() )
+        setNotional(risk, risk.mark * risk.position);
+}
+
+void RiskEngine::updateMarket(const LiveEquity& eq)
+{
+    updateMarket(eq.getSymbol(), eq.getBidPrice(), eq.getAskPrice(), eq.getLastPrice());
+}
+
+void RiskEngine::onFill(const SymbolId symbol_, const int side, const int quantity, const Price price)
+{
+    SymbolRisk& risk = getSymbol(symbol_);
+
+    risk.position += side == BUY ? quantity : -quantity;
+
+    if( risk.mark.isMissing() )
+        risk.mark = price;
+
+    if( !risk.mark.isMissing() )
+        setNotional(risk, risk.mark * risk.position);
+}
+
+/*---------- CHECKS ----------*/
+
+int RiskEngine::check(const Order& order) const
+{
+    /*
+    checks run cheapest first and stop at the first failure, limits that
+    only grow the exposure are enforced so an order that reduces a breached
+    position or notional is always let through
+    */
+
+    static const SymbolRisk unknown{ -1, -1, 0, Price::missing(), Price::missing(), Price::missing(), Money() };
+
+    const SymbolRisk& risk = order.symbol < symbols.size() ? symbols[order.symbol] : unknown;
+
+    // order size
+    const int max_order_shares = risk.max_order_shares < 0 ? limits.max_order_shares : risk.max_order_shares;
+
+    if( order.quantity <= 0 || order.quantity > max_order_shares )
+        return RISK_ORDER_SIZE;
+
+    if( order.price * order.quantity > limits.max_order_notional )
+        return RISK_ORDER_NOTIONAL;
+
+    // fat-finger band around the side of the book the order would trade against
+    const Price reference = order.side == BUY ? risk.ask : risk.bid;
+
+    if( reference.isMissing() )
+    {
+        if( limits.require_market )
+            return RISK_NO_MARKET;
+    }
+    else
+    {
+        const Price band = reference.scaledBy(limits.price_band_bps, 10000);
+
+        if( order.side == BUY ? order.price > reference + band : order.price < reference - band )
+            return RISK_PRICE_BAND;
+    }
+
+    // position
+    const std::int64_t position = risk.position + (order.side == BUY ? order.quantity : -order.quantity);
+    const std::int64_t max_position_shares = risk.max_position_shares < 0 ? limits.max_position_shares : risk.max_position_shares;
+
+    if( absolute(position) > max_position_shares && absolute(position) > absolute(risk.position) )
+        return RISK_POSITION_LIMIT;
+
+    // gross and net notional with this symbol revalued at its new position
+    const Money notional = (risk.mark.isMissing() ? order.price : risk.mark) * position;
+    const Money gross = gross_notional - absolute(risk.notional) + absolute(notional);
+    const Money net = net_notional - risk.notional + notional;
+
+    if( gross > limits.max_gross_notional && gross > gross_notional )
+        return RISK_GROSS_LIMIT;
+
+    if( absolute(net) > limits.max_net_notional && absolute(net) > absolute(net_notional) )
+        return RISK_NET_LIMIT;
+
+    return RISK_ACCEPTED;
+}
+
+} // namespace
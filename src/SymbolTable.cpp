@@ -0,0 +1,87 @@
+/**
+ * @file    SymbolTable.cpp
+ * @brief   Defines the SymbolTable class functionality.
+ *
+ * This file contains the interning and lookup functions of the SymbolTable class.
+ * Lookups of known tickers only take the shared lock, so threads loading data or
+ * handling market data callbacks do not serialize on each other.
+ *
+ * @author  Benny Zaionz
+ * @date    2026-10-18
+ * @version 1.0
+ */
+
+#include <mutex>
+#include <stdexcept>
+
+#include "SymbolTable.h"
+
+namespace AlgoTrading
+{
+
+SymbolTable& SymbolTable::instance()
+{
+    static SymbolTable table;
+    return table;
+}
+
+/*---------- INTERNING ----------*/
+
+SymbolId SymbolTable::intern(std::string_view ticker_)
+{
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+
+        auto it = ids.find(ticker_);
+
+        if( it != ids.end() )
+            return it->second;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex);
+
+    // another thread may have added it between the two locks
+    auto it = ids.find(ticker_);
+
+    if( it != ids.end() )
+        return it->second;
+
+    const SymbolId symbol = static_cast<SymbolId>(tickers.size());
+
+    tickers.emplace_back(ticker_);
+    ids.emplace(tickers.back(), symbol);
+
+    return symbol;
+}
+
+SymbolId SymbolTable::find(std::string_view ticker_) const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex);
+
+    auto it = ids.find(ticker_);
+
+    if( it == ids.end() )
+        return INVALID_SYMBOL;
+
+    return it->second;
+}
+
+/*---------- GETTERS ----------*/
+
+const std::string& SymbolTable::getTicker(const SymbolId symbol) const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex);
+
+    if( symbol >= tickers.size() )
+        throw std::out_of_range("Unknown SymbolId: " + std::to_string(symbol));
+
+    return tickers[symbol];
+}
+
+std::size_t SymbolTable::size() const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return tickers.size();
+}
+
+} // namespace
@@ -0,0 +1,231 @@
+/**
+ * @file    ThreadPool.cpp
+ * @brief   Defines the ThreadPool class functionality.
+ *
+ * This file contains the worker loop of the ThreadPool class and the lock-free
+ * take and steal operations on the per-worker index ranges.
+ *
+ * @author  Benny Zaionz
+ * @date    2026-10-18
+ * @version 1.0
+ */
+
+#include <algorithm>
+
+#include "ThreadPool.h"
+
+namespace AlgoTrading
+{
+
+namespace
+{
+
+std::uint64_t packRange(const std::uint32_t begin, const std::uint32_t end)
+{
+    return (static_cast<std::uint64_t>(begin) << 32) | end;
+}
+
+std::uint32_t rangeBegin(const std::uint64_t bounds) { return static_cast<std::uint32_t>(bounds >> 32); }
+std::uint32_t rangeEnd(const std::uint64_t bounds) { return static_cast<std::uint32_t>(bounds); }
+
+std::uint64_t nextRandom(std::uint64_t& seed)
+{
+    // xorshift64, only picks where to start looking for work
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+    return seed;
+}
+
+} // anonymous namespace
+
+/*---------- CONSTRUCTOR ----------*/
+
+ThreadPool::ThreadPool(const int num_threads):
+    threads{},
+    ranges{},
+    generation(0),
+    num_working(0),
+    stopping(false),
+    job(nullptr),
+    failed(false),
+    error{}
+{
+    int count = num_threads > 0 ? num_threads : static_cast<int>(std::thread::hardware_concurrency());
+    count = std::max(count, 1);
+
+    ranges = std::make_unique<WorkRange[]>(count);
+
+    for( int i = 0; i < count; i++ )
+        ranges[i].bounds.store(0, std::memory_order_relaxed);
+
+    threads.reserve(count);
+
+    for( int i = 0; i < count; i++ )
+        threads.emplace_back(&ThreadPool::workerLoop, this, i);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+
+    wake.notify_all();
+
+    for( std::thread& thread : threads )
+        thread.join();
+}
+
+/*---------- RUNNING ----------*/
+
+void ThreadPool::parallelFor(const int count, const std::function<void(int, int)>& fn)
+{
+    if( count <= 0 )
+        return;
+
+    std::lock_guard<std::mutex> run_lock(run_mutex);
+
+    const int num_threads = threads.size();
+
+    // contiguous equal shares, neighbouring indices tend to cost about the same
+    for( int i = 0; i < num_threads; i++ )
+        ranges[i].bounds.store(packRange(static_cast<std::uint64_t>(count) * i / num_threads,
+                                         static_cast<std::uint64_t>(count) * (i + 1) / num_threads),
+                               std::memory_order_relaxed);
+
+    std::unique_lock<std::mutex> lock(mutex);
+
+    job = &fn;
+    failed.store(false, std::memory_order_relaxed);
+    error = nullptr;
+    num_working = num_threads;
+    generation++;
+
+    wake.notify_all();
+    finished.wait(lock, [this]() { return num_working == 0; });
+
+    job = nullptr;
+
+    if( error )
+        std::rethrow_exception(error);
+}
+
+void ThreadPool::workerLoop(const int worker)
+{
+    std::uint64_t seen = 0;
+
+    while( true )
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&]() { return stopping || generation != seen; });
+
+            if( stopping )
+                return;
+
+            seen = generation;
+        }
+
+        work(worker);
+
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if( --num_working == 0 )
+            finished.notify_one();
+    }
+}
+
+void ThreadPool::work(const int worker)
+{
+    std::uint64_t seed = 0x9E3779B97F4A7C15ULL * (worker + 1);
+    int index = 0;
+
+    do
+    {
+        while( !failed.load(std::memory_order_relaxed) && take(worker, index) )
+        {
+            try
+            {
+                (*job)(index, worker);
+            }
+            catch( ... )
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+
+                if( !error )
+                    error = std::current_exception();
+
+                failed.store(true, std::memory_order_relaxed);
+            }
+        }
+    }
+    while( !failed.load(std::memory_order_relaxed) && steal(worker, seed) );
+}
+
+bool ThreadPool::take(const int worker, int& index)
+{
+    std::atomic<std::uint64_t>& bounds = ranges[worker].bounds;
+    std::uint64_t current = bounds.load(std::memory_order_acquire);
+
+    while( true )
+    {
+        const std::uint32_t begin = rangeBegin(current);
+        const std::uint32_t end = rangeEnd(current);
+
+        if( begin >= end )
+            return false;
+
+        if( bounds.compare_exchange_weak(current, packRange(begin + 1, end), std::memory_order_acq_rel) )
+        {
+            index = begin;
+            return true;
+        }
+    }
+}
+
+bool ThreadPool::steal(const int worker, std::uint64_t& seed)
+{
+    /*
+    takes the back half of the first non-empty range found, starting from a random
+    worker so thieves spread out, and makes it this worker's own range. Own ranges
+    are only ever replaced while empty and nobody CASes an empty range, so the plain
+    store cannot lose a concurrent update. Returns false once every range looked empty
+    */
+
+    const int num_threads = threads.size();
+    const int start = static_cast<int>(nextRandom(seed) % num_threads);
+
+    for( int i = 0; i < num_threads; i++ )
+    {
+        const int victim = (start + i) % num_threads;
+
+        if( victim == worker )
+            continue;
+
+        std::atomic<std::uint64_t>& bounds = ranges[victim].bounds;
+        std::uint64_t current = bounds.load(std::memory_order_acquire);
+
+        while( true )
+        {
+            const std::uint32_t begin = rangeBegin(current);
+            const std::uint32_t end = rangeEnd(current);
+
+            if( begin >= end )
+                break;
+
+            const std::uint32_t middle = begin + (end - begin) / 2; // the victim keeps [begin, middle), one left means it is taken
+
+            if( bounds.compare_exchange_weak(current, packRange(begin, middle), std::memory_order_acq_rel) )
+            {
+                ranges[worker].bounds.store(packRange(middle, end), std::memory_order_release);
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+} // namespace
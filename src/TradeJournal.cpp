@@ -0,0 +1,311 @@
+/**
+ * @file    TradeJournal.cpp
+ * @brief   Defines the TradeJournal class functionality.
+ *
+ * This file contains opening (and repairing) a journal, the group-committed record
+ * writer and the memory mapped record access that replay() runs over. The file is
+ * written through a raw descriptor rather than a stream so each group can be synced.
+ *
+ * @author  Benny Zaionz
+ * @date    2026-10-18
+ * @version 1.0
+ */
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+#ifdef _WIN32
+    #include <fcntl.h>
+    #include <io.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+#include "Portfolio.h"
+#include "TradeJournal.h"
+
+namespace AlgoTrading
+{
+
+namespace
+{
+
+std::int64_t nowNanoseconds()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+bool validHeader(const JournalFileHeader& header)
+{
+    return std::memcmp(header.magic, JOURNAL_MAGIC, sizeof(header.magic)) == 0 &&
+           header.version == JOURNAL_VERSION &&
+           header.record_size == sizeof(JournalRecord);
+}
+
+/*---------- FILE ACCESS ----------*/
+
+int openForAppend(const std::string& path)
+{
+#ifdef _WIN32
+    return ::_open(path.c_str(), _O_WRONLY | _O_APPEND | _O_CREAT | _O_BINARY, 0644);
+#else
+    return ::open(path.c_str(), O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0644);
+#endif
+}
+
+// false on any error, retries short writes
+bool writeAll(const int fd, const char* data, std::size_t size)
+{
+    while( size > 0 )
+    {
+#ifdef _WIN32
+        const int written = ::_write(fd, data, static_cast<unsigned int>(size));
+#else
+        const ssize_t written = ::write(fd, data, size);
+#endif
+
+        if( written <= 0 )
+            return false;
+
+        data += written;
+        size -= written;
+    }
+
+    return true;
+}
+
+bool syncFile(const int fd)
+{
+#ifdef _WIN32
+    return ::_commit(fd) == 0;
+#elif defined(__APPLE__)
+    return ::fsync(fd) == 0;
+#else
+    return ::fdatasync(fd) == 0;
+#endif
+}
+
+// cuts the file back to size, for undoing a group that was only partly written
+bool truncateFile(const int fd, const std::uint64_t size)
+{
+#ifdef _WIN32
+    return ::_chsize_s(fd, static_cast<long long>(size)) == 0;
+#else
+    return ::ftruncate(fd, static_cast<off_t>(size)) == 0;
+#endif
+}
+
+JournalFileHeader makeHeader()
+{
+    JournalFileHeader header = {};
+
+    std::memcpy(header.magic, JOURNAL_MAGIC, sizeof(header.magic));
+    header.version = JOURNAL_VERSION;
+    header.record_size = sizeof(JournalRecord);
+
+    return header;
+}
+
+void closeFile(const int fd)
+{
+#ifdef _WIN32
+    ::_close(fd);
+#else
+    ::close(fd);
+#endif
+}
+
+} // anonymous namespace
+
+/*---------- CONSTRUCTOR ----------*/
+
+TradeJournal::TradeJournal(const std::string& path_, const std::size_t group_size_, const std::int64_t max_delay_):
+fd(-1), path(path_), pending{}, group_size(group_size_ > 0 ? group_size_ : 1), max_delay(max_delay_), next_sequence(1), synced_size(0)
+{
+    const JournalFileHeader expected = makeHeader();
+
+    std::error_code error;
+    bool exists = std::filesystem::exists(path, error);
+
+    if( exists )
+    {
+        const std::uintmax_t size = std::filesystem::file_size(path);
+        JournalFileHeader header;
+
+        std::ifstream in(path, std::ios::binary);
+
+        if( size < sizeof(header) )
+        {
+            /*
+            a crash between creating the file and syncing its header leaves it empty or with part of
+            the header, nothing was ever recorded to it, so it is started again
+            */
+            char start[sizeof(header)] = {};
+
+            if( !in.read(start, size) || std::memcmp(start, &expected, size) != 0 )
+                throw std::runtime_error("Not a trade journal: " + path);
+
+            in.close();
+            std::filesystem::resize_file(path, 0);
+            exists = false;
+        }
+        else
+        {
+            if( !in.read(reinterpret_cast<char*>(&header), sizeof(header)) || !validHeader(header) )
+                throw std::runtime_error("Not a trade journal: " + path);
+
+            in.close();
+
+            const std::uintmax_t count = (size - sizeof(header)) / sizeof(JournalRecord);
+            const std::uintmax_t whole = sizeof(header) + count * sizeof(JournalRecord);
+
+            if( whole != size ) // a crash mid write, drop the partial record so appends stay aligned
+                std::filesystem::resize_file(path, whole);
+
+            next_sequence = count + 1;
+            synced_size = whole;
+        }
+    }
+
+    fd = openForAppend(path);
+
+    if( fd < 0 )
+        throw std::runtime_error("Could not open trade journal: " + path);
+
+    if( !exists )
+    {
+        if( !writeAll(fd, reinterpret_cast<const char*>(&expected), sizeof(expected)) || !syncFile(fd) )
+        {
+            closeFile(fd);
+            throw std::runtime_error("Could not write trade journal header: " + path);
+        }
+
+        synced_size = sizeof(expected);
+    }
+
+    pending.reserve(group_size);
+}
+
+TradeJournal::~TradeJournal()
+{
+    try
+    {
+        flush();
+    }
+    catch( const std::runtime_error& )
+    {
+        // nowhere to report it from a destructor, the records are lost as in a crash
+    }
+
+    closeFile(fd);
+}
+
+/*---------- RECORDING ----------*/
+
+std::uint64_t TradeJournal::append(JournalRecord& record, std::string_view ticker_)
+{
+    if( ticker_.size() > JOURNAL_MAX_TICKER )
+        throw std::invalid_argument("Ticker too long for trade journal: " + std::string(ticker_));
+
+    std::memcpy(record.ticker, ticker_.data(), ticker_.size());
+
+    record.sequence = next_sequence++;
+    record.timestamp = nowNanoseconds();
+
+    pending.push_back(record);
+
+    if( pending.size() >= group_size || record.timestamp - pending.front().timestamp >= max_delay )
+        flush();
+
+    return record.sequence;
+}
+
+std::uint64_t TradeJournal::recordFill(std::string_view ticker_, const int side, const int quantity, const Price price, const Money commission)
+{
+    JournalRecord record = {};
+
+    record.type = side == BUY ? JOURNAL_BUY : JOURNAL_SELL;
+    record.side = static_cast<std::uint16_t>(side);
+    record.status = SUCCESSFUL_TRADE;
+    record.quantity = quantity;
+    record.price = price.getTicks();
+    record.amount = commission.getTicks();
+
+    return append(record, ticker_);
+}
+
+std::uint64_t TradeJournal::recordRejection(std::string_view ticker_, const int side, const int quantity, const Price price, const int status)
+{
+    JournalRecord record = {};
+
+    record.type = JOURNAL_REJECTION;
+    record.side = static_cast<std::uint16_t>(side);
+    record.status = status;
+    record.quantity = quantity;
+    record.price = price.getTicks();
+
+    return append(record, ticker_);
+}
+
+std::uint64_t TradeJournal::recordCashAdjustment(const Money amount)
+{
+    JournalRecord record = {};
+
+    record.type = JOURNAL_CASH_ADJUSTMENT;
+    record.amount = amount.getTicks();
+
+    return append(record, std::string_view());
+}
+
+void TradeJournal::flush()
+{
+    if( pending.empty() )
+        return;
+
+    const std::uint64_t size = pending.size() * sizeof(JournalRecord);
+
+    // one write and one sync per group instead of one per record
+    if( !writeAll(fd, reinterpret_cast<const char*>(pending.data()), size) || !syncFile(fd) )
+    {
+        // whatever part of the group did reach the file is cut off, so a retry writes each record once
+        truncateFile(fd, synced_size);
+        throw std::runtime_error("Could not write trade journal: " + path);
+    }
+
+    synced_size += size;
+    pending.clear();
+}
+
+/*---------- REPLAY ----------*/
+
+std::span<const JournalRecord> TradeJournal::getRecords(const MappedFile& file, const std::string& path)
+{
+    JournalFileHeader header;
+
+    if( file.size() < sizeof(header) )
+        throw std::runtime_error("Not a trade journal: " + path);
+
+    std::memcpy(&header, file.data(), sizeof(header));
+
+    if( !validHeader(header) )
+        throw std::runtime_error("Not a trade journal: " + path);
+
+    const std::size_t count = (file.size() - sizeof(header)) / sizeof(JournalRecord);
+
+    // records start 64 bytes into a page aligned mapping, so they are aligned
+    return std::span<const JournalRecord>(reinterpret_cast<const JournalRecord*>(file.data() + sizeof(header)), count);
+}
+
+std::vector<JournalRecord> TradeJournal::readAll(const std::string& path)
+{
+    MappedFile file(path);
+    std::span<const JournalRecord> records = getRecords(file, path);
+
+    return std::vector<JournalRecord>(records.begin(), records.end());
+}
+
+} // namespace
@@ -0,0 +1,477 @@
+/**
+ * @file    VectorBacktest.cpp
+ * @brief   Defines runVectorized and the vectorized signal functions.
+ *
+ * This file contains the signal functions and runVectorized. The signals work in
+ * blocks of rows, each a few vectorizable passes over prefix sums of the prices in
+ * ticks with only a block sized scratch buffer. The fills are simulated in one scalar
+ * pass that only does work on bars where the position changes, the equity between
+ * two fills is one tight loop per segment of bars.
+ *
+ * @author  Benny Zaionz
+ * @date    2026-10-18
+ * @version 1.0
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "VectorBacktest.h"
+
+namespace AlgoTrading
+{
+
+namespace
+{
+
+void checkSignal(std::span<const double> prices, std::span<int> targets, const int window)
+{
+    if( targets.size() < prices.size() )
+        throw std::invalid_argument("Signal targets must be at least as long as prices");
+
+    if( window < 1 )
+        throw std::invalid_argument("Signal window must be at least 1, got: " + std::to_string(window));
+}
+
+class VectorRun
+{
+    /*
+    the state of one runVectorized call. Between two fills cash and shares are constant, so the
+    bars from one fill to the next are a segment valued cash + shares * last in one tight loop
+    */
+
+    private:
+
+        std::span<const double> last;
+        std::span<const double> fill;
+        std::span<const double> bid;
+        std::span<const double> ask;
+        std::span<double> equity;
+        const BacktestConfig& config;
+        const IbkrFixedFees fees;
+        const std::string& ticker;
+
+        int segment; // first bar valued with the current cash and shares
+        double peak;
+        double trough; // lowest value since peak
+        bool positive; // every last price valued so far was > 0
+
+        void sample(const double value);
+
+    public:
+
+        Money cash;
+        int shares;
+        int num_fills;
+        int num_rejected;
+        Money commissions;
+        double max_drawdown;
+
+        VectorRun(const HistoricalEquityData& hist, const BacktestConfig& config_, std::span<double> equity_);
+
+        void closeSegment(const int end); // values the bars [segment, end)
+        void execute(const int i, const int quantity); // an order filled at bar i, Portfolio's checks and fees
+        void finish(); // values the remaining bars
+};
+
+VectorRun::VectorRun(const HistoricalEquityData& hist, const BacktestConfig& config_, std::span<double> equity_):
+    last(hist.getPriceColumn(LAST)),
+    fill(hist.getPriceColumn(config_.fill_price_type)),
+    bid(hist.getPriceColumn(BID)),
+    ask(hist.getPriceColumn(ASK)),
+    equity(equity_),
+    config(config_),
+    fees{},
+    ticker(hist.getTicker()),
+    segment(0),
+    peak(0),
+    trough(0),
+    positive(true),
+    cash(Money::fromDouble(config_.initial_cash)),
+    shares(0),
+    num_fills(0),
+    num_rejected(0),
+    commissions(),
+    max_drawdown(0)
+{
+    if( fill.size() != last.size() )
+        throw std::invalid_argument("Unknown fill_price_type: " + std::to_string(config.fill_price_type));
+
+    peak = trough = cash.toDouble();
+}
+
+void VectorRun::sample(const double value)
+{
+    // same sampling as Backtest::closeTimestamp, the deepest drawdown under a peak is at the trough
+    if( value > peak )
+    {
+        if( peak > 0 )
+            max_drawdown = std::max(max_drawdown, (peak - trough) / peak);
+
+        peak = trough = value;
+    }
+    else
+        trough = std::min(trough, value);
+}
+
+void VectorRun::closeSegment(const int end)
+{
+    const double cash_value = cash.toDouble();
+    const double held = shares;
+
+    if( segment >= end )
+        return;
+
+    if( shares == 0 ) // flat, every bar has the same value and last is not needed
+    {
+        if( !equity.empty() )
+            std::fill(equity.begin() + segment, equity.begin() + end, cash_value);
+
+        sample(cash_value);
+        segment = end;
+        return;
+    }
+
+    /*
+    blocks of 8 bars without a new peak fold into the trough with one min over the block,
+    which keeps the running min from becoming a dependency chain as long as the segment
+    */
+
+    int i = segment;
+    const double* prices = last.data(); // plain pointers, loads through the members would alias them
+    double* curve = equity.empty() ? nullptr : equity.data();
+
+    for( ; i + 8 <= end; i += 8 )
+    {
+        double values[8];
+        int block_positive = 1;
+
+        for( int k = 0; k < 8; k++ )
+            values[k] = cash_value + held * prices[i + k];
+
+        for( int k = 0; k < 8; k++ )
+            block_positive &= prices[i + k] > 0;
+
+        positive &= block_positive;
+
+        if( curve != nullptr )
+            std::copy(values, values + 8, curve + i);
+
+        const double block_max = std::max(std::max(std::max(values[0], values[1]), std::max(values[2], values[3])),
+                                          std::max(std::max(values[4], values[5]), std::max(values[6], values[7])));
+
+        if( block_max <= peak )
+        {
+            trough = std::min(trough, std::min(std::min(std::min(values[0], values[1]), std::min(values[2], values[3])),
+                                               std::min(std::min(values[4], values[5]), std::min(values[6], values[7]))));
+            continue;
+        }
+
+        for( int k = 0; k < 8; k++ )
+            sample(values[k]);
+    }
+
+    for( ; i < end; i++ )
+    {
+        const double value = cash_value + held * last[i];
+
+        positive &= last[i] > 0;
+
+        if( !equity.empty() )
+            equity[i] = value;
+
+        sample(value);
+    }
+
+    segment = end;
+}
+
+void VectorRun::execute(const int i, const int quantity)
+{
+    const int side = quantity > 0 ? BUY : SELL;
+    const int amount = quantity > 0 ? quantity : -quantity;
+
+    double quote = -1;
+
+    if( config.cross_spread )
+        quote = side == BUY ? ask[i] : bid[i];
+
+    if( !(quote > 0) )
+        quote = fill[i];
+
+    if( !(quote > 0) )
+        throw std::invalid_argument("runVectorized has no fill price at row " + std::to_string(i) + " of " + ticker);
+
+    const Price price = Price::fromDouble(quote);
+    const Money commission = fees.commission(side, amount, price);
+
+    if( side == BUY ? cash <= price * amount + commission : shares < amount )
+    {
+        num_rejected++;
+        return;
+    }
+
+    closeSegment(i);
+
+    if( side == BUY )
+    {
+        cash -= price * amount + commission;
+        shares += amount;
+    }
+    else
+    {
+        cash += price * amount - commission;
+        shares -= amount;
+    }
+
+    commissions += commission;
+    num_fills++;
+}
+
+void VectorRun::finish()
+{
+    closeSegment(last.size());
+
+    if( peak > 0 )
+        max_drawdown = std::max(max_drawdown, (peak - trough) / peak);
+
+    if( !positive )
+        throw std::invalid_argument("runVectorized needs a positive last price on every bar a position is held, " + ticker + " has none on some");
+}
+
+const int SIGNAL_BLOCK = 2048; // rows of targets per block, the block's sums stay in L1
+
+/*
+loop(offset, count) over the history rows before a block and then over its own rows, the latter with
+a constant count when the block is full since GCC's -O2 cost model only vectorizes loops of known length
+*/
+template<typename Loop>
+void forBlockRows(const int history, const int rows, const Loop& loop)
+{
+    loop(0, history);
+
+    if( rows == SIGNAL_BLOCK )
+        loop(history, SIGNAL_BLOCK);
+    else
+        loop(history, rows);
+}
+
+/*
+the prices of rows [first, end) in ticks less center, rows [first, begin) being the history the windows
+of the block need: ticks[k] is row first + k. Unsigned so sums of them wrap instead of overflowing, the
+difference of two prefix sums is still exact while the sum it stands for fits
+*/
+void roundTicks(std::span<const double> prices, const int first, const int begin, const int end, const std::int64_t center, std::uint64_t* ticks)
+{
+    const double* rows = prices.data() + first;
+
+    forBlockRows(begin - first, end - begin, [&](const int offset, const int count) {
+        for( int k = offset; k < offset + count; k++ )
+            ticks[k] = static_cast<std::uint64_t>(Price::fromDouble(rows[k]).getTicks() - center);
+    });
+}
+
+// values[0] = 0 and values[k] becomes the sum of the first k values, the one loop carried add left
+void prefixSums(std::uint64_t* values, const int count)
+{
+    values[0] = 0;
+
+    for( int k = 1; k <= count; k++ )
+        values[k] += values[k - 1];
+}
+
+} // anonymous namespace
+
+/*---------- SIGNALS ----------*/
+
+/*
+prices are rounded to ticks (as Price::fromDouble) and summed in integers, so the sums are exact and the
+signal is the same however they are accumulated. Each block of SIGNAL_BLOCK rows takes the prefix sums of
+its rows and the window before them, every rolling sum is then one difference of two of them, so the
+signals have no loop carried dependency and vectorize
+*/
+
+void movingAverageCrossTargets(std::span<const double> prices, const int fast, const int slow, const int shares, std::span<int> targets)
+{
+    checkSignal(prices, targets, std::min(fast, slow));
+
+    const int n = prices.size();
+    const int longest = std::max(fast, slow);
+
+    std::vector<std::uint64_t> sums(SIGNAL_BLOCK + longest);
+
+    std::fill(targets.begin(), targets.begin() + std::min(longest - 1, n), 0);
+
+    for( int begin = longest - 1; begin < n; begin += SIGNAL_BLOCK )
+    {
+        const int end = std::min(begin + SIGNAL_BLOCK, n);
+        const int first = begin + 1 - longest; // first row of the window of begin
+
+        roundTicks(prices, first, begin, end, 0, sums.data() + 1);
+        prefixSums(sums.data(), end - first);
+
+        // row begin + k ends at at_end[k], fast_sum / fast > slow_sum / slow without dividing
+        const std::uint64_t* at_end = sums.data() + longest;
+        int* out = targets.data() + begin;
+
+        forBlockRows(0, end - begin, [&](const int offset, const int count) {
+            for( int k = offset; k < offset + count; k++ )
+            {
+                const std::int64_t fast_sum = static_cast<std::int64_t>(at_end[k] - at_end[k - fast]);
+                const std::int64_t slow_sum = static_cast<std::int64_t>(at_end[k] - at_end[k - slow]);
+
+                out[k] = fast_sum * slow > slow_sum * fast ? shares : 0;
+            }
+        });
+    }
+}
+
+void zScoreTargets(std::span<const double> prices, const int window, const double entry, const double exit, const int shares, std::span<int> targets)
+{
+    checkSignal(prices, targets, window);
+
+    const int n = prices.size();
+    const double scale = 1.0 / window;
+
+    /*
+    the ticks are less the first price of the block's windows, so the sum of squares over a window is exact
+    while window * move^2 < 2^63, the move being the largest distance in ticks from that price within the
+    block (at a window of 1000 a move of $9.6k), whatever the price itself
+    */
+    const double largest_move = std::sqrt(9.2e18 / window);
+
+    std::vector<std::uint64_t> sums(SIGNAL_BLOCK + window);
+    std::vector<std::uint64_t> squares(SIGNAL_BLOCK + window);
+
+    std::fill(targets.begin(), targets.begin() + std::min(window - 1, n), 0);
+
+    for( int begin = window - 1; begin < n; begin += SIGNAL_BLOCK )
+    {
+        const int end = std::min(begin + SIGNAL_BLOCK, n);
+        const int first = begin + 1 - window;
+        const std::int64_t center = Price::fromDouble(prices[first]).getTicks();
+
+        roundTicks(prices, first, begin, end, center, sums.data() + 1);
+
+        std::uint64_t move = 0;
+
+        forBlockRows(begin - first, end - begin, [&](const int offset, const int count) {
+            for( int k = offset + 1; k <= offset + count; k++ )
+            {
+                const std::uint64_t distance = sums[k] >> 63 ? -sums[k] : sums[k];
+
+                move = std::max(move, distance);
+                squares[k] = distance * distance;
+            }
+        });
+
+        if( static_cast<double>(move) >= largest_move )
+            throw std::invalid_argument("zScoreTargets: prices move too far within " + std::to_string(end - first) +
+                                        " rows for a window of " + std::to_string(window));
+
+        prefixSums(sums.data(), end - first);
+        prefixSums(squares.data(), end - first);
+
+        /*
+        in ticks less center, 0 where the window has no spread. The entry / exit hysteresis depends on the
+        previous position, so the block's pass writes which way each row points (1 enter, -1 exit, 0 hold)
+        into targets and a scalar pass turns that into positions
+        */
+        const std::uint64_t* sum_end = sums.data() + window;
+        const std::uint64_t* squares_end = squares.data() + window;
+        int* out = targets.data() + begin;
+
+        forBlockRows(0, end - begin, [&](const int offset, const int count) {
+            for( int k = offset; k < offset + count; k++ )
+            {
+                const std::int64_t sum = static_cast<std::int64_t>(sum_end[k] - sum_end[k - window]);
+                const std::uint64_t sum_squares = squares_end[k] - squares_end[k - window];
+                const std::int64_t ticks = static_cast<std::int64_t>(sum_end[k] - sum_end[k - 1]);
+
+                const double mean = sum * scale;
+                const double variance = static_cast<double>(sum_squares) * scale - mean * mean;
+                const double z = variance > 0 ? (ticks - mean) / std::sqrt(variance) : 0;
+
+                out[k] = z < -entry ? 1 : (z > -exit ? -1 : 0);
+            }
+        });
+    }
+
+    int position = 0;
+
+    for( int i = window - 1; i < n; i++ )
+    {
+        position = targets[i] > 0 ? shares : (targets[i] < 0 ? 0 : position);
+        targets[i] = position;
+    }
+}
+
+/*---------- RUNNING ----------*/
+
+BacktestResult runVectorized(const HistoricalEquityData& hist,
+                             std::span<const int> targets,
+                             const BacktestConfig& config,
+                             std::span<double> equity)
+{
+    const int n = hist.getSize();
+
+    if( targets.size() < std::size_t(n) || ( !equity.empty() && equity.size() < std::size_t(n) ) )
+        throw std::invalid_argument("runVectorized needs a target (and an equity value) for every bar of " + hist.getTicker());
+
+    if( !hist.isChronological() )
+        throw std::invalid_argument("runVectorized needs chronological data, " + hist.getTicker() + " is not");
+
+    VectorRun run(hist, config, equity);
+
+    /*
+    the bars where the position is already on target are skipped by a bare scan of targets,
+    an order placed at bar i (targets[i] != shares) fills at i with FILL_THIS_BAR or at i + 1,
+    where the scan resumes because bar i + 1 places its own order after the fill, exactly as
+    Backtest::orderTarget would on every bar
+    */
+
+    const bool next_bar = config.fill_timing == FILL_NEXT_BAR;
+    int i = 0;
+
+    while( true )
+    {
+        const int shares = run.shares;
+
+        while( i < n && targets[i] == shares )
+            i++;
+
+        if( i >= n || ( next_bar && i + 1 >= n ) ) // an order from the last bar never fills
+            break;
+
+        const int order = targets[i] - shares;
+
+        if( next_bar )
+            i++;
+
+        run.execute(i, order);
+
+        if( !next_bar )
+            i++;
+    }
+
+    run.finish();
+
+    BacktestResult result;
+
+    result.initial_value = config.initial_cash;
+    result.final_value = (run.shares != 0 ? run.cash + Price::fromDouble(hist.getPriceColumn(LAST)[n - 1]) * run.shares : run.cash).toDouble();
+    result.total_return = result.initial_value > 0 ? result.final_value / result.initial_value - 1 : 0;
+    result.max_drawdown = run.max_drawdown;
+    result.commissions = run.commissions.toDouble();
+    result.num_fills = run.num_fills;
+    result.num_rejected = run.num_rejected;
+    result.num_bars = n;
+
+    return result;
+}
+
+} // namespace
@@ -1,6 +1,7 @@
 #include <iostream>
 #include <string>
 
+#include "BarResampler.h"
 #include "Portfolio.h"
 #include "HistoricalEquityData.h"
 #include "DateTime.h"
@@ -54,5 +55,35 @@ int main()
 
     p.print();
 
-    return 0;
+    // live ticks carry only last (low and high are -1), the minute bar must still get its range from them
+    AlgoTrading::BarResampler resampler;
+    const int minutes = resampler.addTarget(AlgoTrading::MINS);
+
+    resampler.update(AlgoTrading::EquitySnapshot("20250618 09:30:05", 100, -1, -1, 99.9, 100.1, 10));
+    resampler.update(AlgoTrading::EquitySnapshot("20250618 09:30:20", 101, -1, -1, 100.9, 101.1, 10));
+    resampler.update(AlgoTrading::EquitySnapshot("20250618 09:30:40", 98, -1, -1, 97.9, 98.1, 10));
+    resampler.flush();
+
+    const AlgoTrading::Bar& minute = resampler.getBars(minutes)[0].trade;
+    const bool ticks_ok = minute.getFirst() == 100 && minute.getLast() == 98 && minute.getLow() == 98 && minute.getHigh() == 101;
+
+    minute.print(AlgoTrading::TRADE);
+    std::cout << "tick stream resampling: " << (ticks_ok ? "OK" : "FAILED") << std::endl;
+
+    // one second bars given the same date past a day's worth of rows keep one second apart into the next day
+    AlgoTrading::HistoricalEquityData seconds("AAPL", AlgoTrading::SECS, 1);
+    const AlgoTrading::DateTime day("20250618");
+    const int rows = 86400 + 100;
+
+    for( int i = 0; i < rows; i++ )
+        seconds.append_data(AlgoTrading::EquitySnapshot("20250618", 100, 99, 101, 99.9, 100.1, 10));
+
+    bool inference_ok = seconds.getSize() == rows;
+
+    for( int i = 0; inference_ok && i < rows; i++ )
+        inference_ok = seconds.getDatetimeColumn()[i].getEpoch() == day.getEpoch() + i;
+
+    std::cout << "timestamp inference past midnight: " << (inference_ok ? "OK" : "FAILED") << std::endl;
+
+    return ticks_ok && inference_ok ? 0 : 1;
 }
\ No newline at end of file